@@ -26,9 +26,11 @@
 #define COMMON_BITSTREAM_H
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 #include "common/textconsole.h"
 #include "common/stream.h"
 #include "common/types.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -71,6 +73,14 @@ public:
 	/** Add a bit to the value x, making it an n+1-bit value. */
 	virtual void addBit(uint32 &x, uint32 n) = 0;
 
+	/** Are the bits of each data value handed out MSB first? */
+	virtual bool isMSBFirst() const = 0;
+
+	/** Is peekBits() followed by skip() about as cheap as a single getBits()? */
+	virtual bool canPeekCheaply() const {
+		return false;
+	}
+
 protected:
 	BitStream() {
 	}
@@ -266,6 +276,10 @@ public:
 			x = (x & ~(1 << n)) | (getBit() << n);
 	}
 
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
+
 	/** Rewind the bit stream back to the start. */
 	void rewind() {
 		_stream->seek(0);
@@ -330,6 +344,234 @@ typedef BitStreamImpl<32, false, true > BitStream32BEMSB;
 /** 32-bit big-endian data, LSB to MSB. */
 typedef BitStreamImpl<32, false, false> BitStream32BELSB;
 
+/**
+ * A bit stream reading from memory.
+ *
+ * It hands out the bits in the same order as BitStreamImpl with the same
+ * layout parameters, but copies all data into a buffer on construction.
+ * There, values whose byte order disagrees with the bit order are swapped,
+ * so that the data can always be read as one big-endian (MSB to LSB) or
+ * little-endian (LSB to MSB) bit string. The buffer is padded, which lets
+ * any access load the 64 bits at the current position without checking
+ * for the end of the data first.
+ */
+template<int valueBits, bool isLE, bool isMSB2LSB>
+class BitStreamMemoryImpl : public BitStream {
+private:
+	byte  *_data; ///< The swapped and padded data.
+	uint32 _size; ///< Size of the data in bits.
+	uint32 _pos;  ///< Current position in bits.
+
+	enum {
+		kPadding = 8
+	};
+
+	void init(const byte *data, uint32 size) {
+		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
+			error("BitStreamMemoryImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+
+		// A partial value at the end can't be read, just like with BitStreamImpl
+		size &= ~((uint32) ((valueBits >> 3) - 1));
+
+		_data = new byte[size + kPadding];
+		memcpy(_data, data, size);
+		memset(_data + size, 0, kPadding);
+
+		if ((valueBits > 8) && (isLE == isMSB2LSB))
+			for (uint32 i = 0; i < size; i += valueBits >> 3)
+				for (int j = 0; j < (valueBits >> 4); j++)
+					SWAP(_data[i + j], _data[i + (valueBits >> 3) - 1 - j]);
+
+		_size = size * 8;
+		_pos  = 0;
+	}
+
+	void init(SeekableReadStream &stream) {
+		const uint32 size = stream.size();
+		byte *data = new byte[size];
+
+		stream.seek(0);
+		if (stream.read(data, size) != size)
+			error("BitStreamMemoryImpl: Read error");
+
+		init(data, size);
+		delete[] data;
+	}
+
+	/** Return the 64 bits at the current position, the next bit being the MSB or LSB. */
+	inline uint64 load() const {
+		if (isMSB2LSB)
+			return READ_BE_UINT64(_data + (_pos >> 3)) << (_pos & 7);
+		else
+			return READ_LE_UINT64(_data + (_pos >> 3)) >> (_pos & 7);
+	}
+
+	/** Return the next n bits, with 1 <= n <= 32. */
+	inline uint32 peek(uint8 n) const {
+		if (isMSB2LSB)
+			return (uint32) (load() >> (64 - n));
+		else
+			return (uint32) (load() & ((((uint64) 1) << n) - 1));
+	}
+
+	inline void checkAvailable(uint32 n) const {
+		if ((_size - _pos) < n)
+			error("BitStreamMemoryImpl: End of bit stream reached");
+	}
+
+public:
+	/** Create a bit stream over a copy of this data. */
+	BitStreamMemoryImpl(const byte *data, uint32 size) {
+		init(data, size);
+	}
+
+	/** Create a bit stream over a copy of this input data stream's contents and optionally delete it. */
+	BitStreamMemoryImpl(SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::NO) {
+		init(*stream);
+
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete stream;
+	}
+
+	/** Create a bit stream over a copy of this input data stream's contents. */
+	BitStreamMemoryImpl(SeekableReadStream &stream) {
+		init(stream);
+	}
+
+	~BitStreamMemoryImpl() {
+		delete[] _data;
+	}
+
+	/** Read a bit from the bit stream. */
+	uint32 getBit() {
+		checkAvailable(1);
+
+		const byte data = _data[_pos >> 3];
+		const uint32 b = isMSB2LSB ? ((data >> (7 - (_pos & 7))) & 1) : ((data >> (_pos & 7)) & 1);
+
+		_pos++;
+		return b;
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream.
+	 *
+	 * @see BitStreamImpl::getBits()
+	 */
+	uint32 getBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemoryImpl::getBits(): Too many bits requested to be read");
+
+		checkAvailable(n);
+
+		uint32 v = peek(n);
+		_pos += n;
+		return v;
+	}
+
+	/** Read a bit from the bit stream, without changing the stream's position. */
+	uint32 peekBit() {
+		checkAvailable(1);
+
+		return peek(1);
+	}
+
+	/** Read a multi-bit value from the bit stream, without changing the stream's position. */
+	uint32 peekBits(uint8 n) {
+		if (n == 0)
+			return 0;
+
+		if (n > 32)
+			error("BitStreamMemoryImpl::peekBits(): Too many bits requested to be read");
+
+		checkAvailable(n);
+
+		return peek(n);
+	}
+
+	/**
+	 * Add a bit to the value x, making it an n+1-bit value.
+	 *
+	 * @see BitStreamImpl::addBit()
+	 */
+	void addBit(uint32 &x, uint32 n) {
+		if (n >= 32)
+			error("BitStreamMemoryImpl::addBit(): Too many bits requested to be read");
+
+		if (isMSB2LSB)
+			x = (x << 1) | getBit();
+		else
+			x = (x & ~(1 << n)) | (getBit() << n);
+	}
+
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
+
+	bool canPeekCheaply() const {
+		return true;
+	}
+
+	/** Rewind the bit stream back to the start. */
+	void rewind() {
+		_pos = 0;
+	}
+
+	/** Skip the specified amount of bits. */
+	void skip(uint32 n) {
+		checkAvailable(n);
+
+		_pos += n;
+	}
+
+	/** Skip the bits to closest data value border. */
+	void align() {
+		_pos = (_pos + valueBits - 1) & ~((uint32) (valueBits - 1));
+	}
+
+	/** Return the stream position in bits. */
+	uint32 pos() const {
+		return _pos;
+	}
+
+	/** Return the stream size in bits. */
+	uint32 size() const {
+		return _size;
+	}
+
+	bool eos() const {
+		return _pos >= _size;
+	}
+};
+
+// typedefs for various memory layouts.
+
+/** 8-bit data, MSB to LSB. */
+typedef BitStreamMemoryImpl<8, false, true > BitStreamMemory8MSB;
+/** 8-bit data, LSB to MSB. */
+typedef BitStreamMemoryImpl<8, false, false> BitStreamMemory8LSB;
+
+/** 16-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, true , true > BitStreamMemory16LEMSB;
+/** 16-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, true , false> BitStreamMemory16LELSB;
+/** 16-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, false, true > BitStreamMemory16BEMSB;
+/** 16-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, false, false> BitStreamMemory16BELSB;
+
+/** 32-bit little-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, true , true > BitStreamMemory32LEMSB;
+/** 32-bit little-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, true , false> BitStreamMemory32LELSB;
+/** 32-bit big-endian data, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, false, true > BitStreamMemory32BEMSB;
+/** 32-bit big-endian data, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, false, false> BitStreamMemory32BELSB;
+
 } // End of namespace Common
 
 #endif // COMMON_BITSTREAM_H
@@ -58,6 +58,8 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 		// And put the pointer to the symbol/code struct into the symbol list.
 		_symbols[i] = &_codes[lengths[i] - 1].back();
 	}
+
+	buildLookupTables();
 }
 
 Huffman::~Huffman() {
@@ -68,7 +70,68 @@ void Huffman::setSymbols(const uint32 *symbols) {
 		_symbols[i]->symbol = symbols ? *symbols++ : i;
 }
 
+void Huffman::buildLookupTables() {
+	_lookupBits = MIN<uint32>(_codes.size(), kLookupBits);
+
+	LookupEntry empty;
+	empty.symbol = 0;
+	empty.length = 0;
+
+	_lookupMSB.resize(1 << _lookupBits);
+	_lookupLSB.resize(1 << _lookupBits);
+
+	for (uint32 i = 0; i < _lookupMSB.size(); i++)
+		_lookupMSB[i] = _lookupLSB[i] = empty;
+
+	// Walk the codes in the same order as getSymbolSlow(), so that the
+	// first matching code wins here too.
+	for (uint32 i = 0; i < _lookupBits; i++) {
+		const uint8 length = i + 1;
+		const uint32 fill = 1 << (_lookupBits - length);
+
+		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode) {
+			// Such a code can never be matched
+			if (cCode->code >> length)
+				continue;
+
+			LookupEntry entry;
+			entry.symbol = &*cCode;
+			entry.length = length;
+
+			// MSB first: the code makes up the top bits of the index
+			for (uint32 j = 0; j < fill; j++) {
+				LookupEntry &e = _lookupMSB[(cCode->code << (_lookupBits - length)) | j];
+				if (!e.symbol)
+					e = entry;
+			}
+
+			// LSB first: the code makes up the bottom bits of the index
+			for (uint32 j = 0; j < fill; j++) {
+				LookupEntry &e = _lookupLSB[cCode->code | (j << length)];
+				if (!e.symbol)
+					e = entry;
+			}
+		}
+	}
+}
+
 uint32 Huffman::getSymbol(BitStream &bits) const {
+	// Peeking on a stream backed bit stream reads the bits one at a time
+	// and seeks back, so the table only pays off on the cheap ones
+	if (bits.canPeekCheaply() && bits.size() - bits.pos() >= _lookupBits) {
+		const LookupTable &lookup = bits.isMSBFirst() ? _lookupMSB : _lookupLSB;
+		const LookupEntry &entry = lookup[bits.peekBits(_lookupBits)];
+
+		if (entry.symbol) {
+			bits.skip(entry.length);
+			return entry.symbol->symbol;
+		}
+	}
+
+	return getSymbolSlow(bits);
+}
+
+uint32 Huffman::getSymbolSlow(BitStream &bits) const {
 	uint32 code = 0;
 
 	for (uint32 i = 0; i < _codes.size(); i++) {
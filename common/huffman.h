@@ -36,6 +36,11 @@ class BitStream;
 /**
  * Huffman bitstream decoding
  *
+ * On bit streams that can peek cheaply, codes of up to kLookupBits bits are
+ * resolved with a single table lookup on the peeked bits. Longer codes,
+ * codes near the end of the stream and all codes read from other bit
+ * streams are decoded bit by bit.
+ *
  * Used in engines:
  *  - scumm
  */
@@ -59,6 +64,11 @@ public:
 	uint32 getSymbol(BitStream &bits) const;
 
 private:
+	enum {
+		/** Maximum number of bits resolved by the lookup table. */
+		kLookupBits = 9
+	};
+
 	struct Symbol {
 		uint32 code;
 		uint32 symbol;
@@ -75,6 +85,24 @@ private:
 
 	/** Sorted list of pointers to the symbols. */
 	SymbolList _symbols;
+
+	struct LookupEntry {
+		const Symbol *symbol; ///< The symbol, or 0 if the code is longer than the table.
+		uint8 length;         ///< Length of the code.
+	};
+
+	typedef Array<LookupEntry> LookupTable;
+
+	/** Number of bits peeked for the lookup tables. */
+	uint8 _lookupBits;
+
+	/** Lookup tables indexed by the next _lookupBits bits, for MSB- and LSB-first streams. */
+	LookupTable _lookupMSB, _lookupLSB;
+
+	void buildLookupTables();
+
+	/** Decode the next symbol bit by bit. */
+	uint32 getSymbolSlow(BitStream &bits) const;
 };
 
 } // End of namespace Common
@@ -0,0 +1,245 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a benchmark comparing the stream based and the memory based bit
+ * stream implementations of common/bitstream.h, for the access patterns the
+ * video and audio decoders use.
+ *
+ * The results are printed as comma separated values, one line per case:
+ *   case,layout,implementation,mbits_per_second
+ * where the number of bits is the number of bits consumed from the stream.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/scummsys.h"
+#include "common/bitstream.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+
+namespace {
+
+/** Minimum time spent running each case, in seconds */
+double g_minTime = 0.25;
+
+/** Optional substring a case name must contain to be run */
+const char *g_filter = 0;
+
+/** Size of the benchmarked data, in bytes */
+const uint32 kDataSize = 64 * 1024;
+
+byte g_data[kDataSize];
+
+/** Prevents the compiler from optimizing the reads away */
+volatile uint32 g_sink;
+
+double now() {
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+void fillPattern() {
+	uint32 seed = 0x12345678;
+	for (uint32 i = 0; i < kDataSize; ++i) {
+		seed = seed * 1103515245 + 12345;
+		g_data[i] = (byte)(seed >> 16);
+	}
+}
+
+bool selected(const char *name) {
+	return !g_filter || strstr(name, g_filter);
+}
+
+/*
+ * The cases. Each one reads through the whole data once and returns the
+ * number of bits consumed.
+ */
+
+uint32 runGetBit(Common::BitStream &bs) {
+	uint32 sum = 0;
+	const uint32 size = bs.size();
+
+	for (uint32 i = 0; i < size; ++i)
+		sum += bs.getBit();
+
+	g_sink = sum;
+	return size;
+}
+
+uint32 runGetBits(Common::BitStream &bs) {
+	// A mix of field sizes, as found in codec headers and residues
+	static const uint8 kSizes[] = { 1, 3, 7, 8, 11, 16, 2, 5, 23, 32 };
+
+	uint32 sum = 0;
+	uint32 bits = 0;
+	const uint32 size = bs.size();
+
+	for (uint i = 0; bits + kSizes[i] <= size; i = (i + 1) % ARRAYSIZE(kSizes)) {
+		sum += bs.getBits(kSizes[i]);
+		bits += kSizes[i];
+	}
+
+	g_sink = sum;
+	return bits;
+}
+
+uint32 runPeekSkip(Common::BitStream &bs) {
+	// Table driven VLC decoding: peek a few bits, skip the code length
+	uint32 sum = 0;
+	uint32 bits = 0;
+	const uint32 size = bs.size();
+
+	while (bits + 8 <= size) {
+		const uint32 v = bs.peekBits(8);
+		const uint32 length = (v & 7) + 1;
+
+		bs.skip(length);
+		bits += length;
+		sum += v;
+	}
+
+	g_sink = sum;
+	return bits;
+}
+
+uint32 runHuffman(Common::BitStream &bs) {
+	// Codes 0, 10, 110, ..., 1111111111, with the first bit in bit 0 for
+	// LSB-first streams
+	static Common::Huffman *huffman[2] = { 0, 0 };
+
+	const int msb = bs.isMSBFirst() ? 1 : 0;
+	if (!huffman[msb]) {
+		uint32 codes[11];
+		uint8 lengths[11];
+
+		for (int i = 0; i < 10; ++i) {
+			lengths[i] = i + 1;
+			codes[i] = msb ? ((1 << (i + 1)) - 2) : ((1 << i) - 1);
+		}
+
+		lengths[10] = 10;
+		codes[10] = (1 << 10) - 1;
+
+		huffman[msb] = new Common::Huffman(0, 11, codes, lengths);
+	}
+
+	uint32 sum = 0;
+	const uint32 size = bs.size();
+
+	while (size - bs.pos() >= 10)
+		sum += huffman[msb]->getSymbol(bs);
+
+	g_sink = sum;
+	return bs.pos();
+}
+
+typedef uint32 (*CaseProc)(Common::BitStream &bs);
+
+struct CaseInfo {
+	const char *name;
+	CaseProc proc;
+};
+
+const CaseInfo kCases[] = {
+	{ "getbit", runGetBit },
+	{ "getbits", runGetBits },
+	{ "peekskip", runPeekSkip },
+	{ "huffman", runHuffman }
+};
+
+/**
+ * Run one case on a bit stream of type B, created for each pass from a
+ * memory stream over the data, as the decoders do.
+ */
+template<class B>
+void report(const CaseInfo &info, const char *layout, const char *impl) {
+	// Warm up caches
+	{
+		Common::MemoryReadStream ms(g_data, kDataSize);
+		B bs(ms);
+		info.proc(bs);
+	}
+
+	double bits = 0;
+	const double start = now();
+	double elapsed = 0;
+	do {
+		Common::MemoryReadStream ms(g_data, kDataSize);
+		B bs(ms);
+		bits += info.proc(bs);
+		elapsed = now() - start;
+	} while (elapsed < g_minTime);
+
+	printf("%s,%s,%s,%.2f\n", info.name, layout, impl, bits / 1000000.0 / elapsed);
+	fflush(stdout);
+}
+
+template<class S, class M>
+void runLayout(const char *layout) {
+	for (uint i = 0; i < ARRAYSIZE(kCases); ++i) {
+		char name[64];
+		snprintf(name, sizeof(name), "%s_%s", kCases[i].name, layout);
+		if (!selected(name))
+			continue;
+
+		report<S>(kCases[i], layout, "stream");
+		report<M>(kCases[i], layout, "memory");
+	}
+}
+
+void runAll() {
+	runLayout<Common::BitStream8MSB, Common::BitStreamMemory8MSB>("8msb");
+	runLayout<Common::BitStream8LSB, Common::BitStreamMemory8LSB>("8lsb");
+	runLayout<Common::BitStream16LEMSB, Common::BitStreamMemory16LEMSB>("16lemsb");
+	runLayout<Common::BitStream32LELSB, Common::BitStreamMemory32LELSB>("32lelsb");
+	runLayout<Common::BitStream32BEMSB, Common::BitStreamMemory32BEMSB>("32bemsb");
+}
+
+} // End of anonymous namespace
+
+int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--time") && i + 1 < argc) {
+			g_minTime = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+			g_filter = argv[++i];
+		} else {
+			printf("Usage: %s [--time seconds] [--filter name]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	fillPattern();
+
+	printf("case,layout,implementation,mbits_per_second\n");
+	runAll();
+	return 0;
+}
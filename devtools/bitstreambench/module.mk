@@ -0,0 +1,14 @@
+
+MODULE := devtools/bitstreambench
+
+MODULE_OBJS := \
+	bitstreambench.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := bitstreambench
+
+# The benchmark links against the bit stream and Huffman code it measures
+TOOL_DEPS := common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
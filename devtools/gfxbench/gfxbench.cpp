@@ -0,0 +1,437 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a benchmark for the 2D graphics pipeline: scalers, blitters and
+ * pixel format conversions. It does not need any backend, since everything
+ * it measures works on plain surfaces in memory.
+ *
+ * The results are printed as comma separated values, one line per case:
+ *   case,width,height,bpp,mpixels_per_second
+ * where the number of pixels is the number of source pixels processed.
+ */
+
+// Disable symbol overrides so that we can use system headers.
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/scummsys.h"
+#include "common/rect.h"
+
+#include "graphics/conversion.h"
+#include "graphics/managed_surface.h"
+#include "graphics/pixelformat.h"
+#include "graphics/scaler.h"
+#include "graphics/surface.h"
+#include "graphics/transform_struct.h"
+#include "graphics/transparent_surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+namespace {
+
+/** Minimum time spent running each case, in seconds */
+double g_minTime = 0.25;
+
+/** Optional substring a case name must contain to be run */
+const char *g_filter = 0;
+
+struct Resolution {
+	int w, h;
+};
+
+const Resolution kResolutions[] = {
+	{ 320, 200 },
+	{ 320, 240 },
+	{ 640, 400 },
+	{ 640, 480 }
+};
+
+double now() {
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+ * Interface of one benchmark case. Setup and tear down happen in the
+ * constructor and destructor, run() does one iteration.
+ */
+class BenchCase {
+public:
+	virtual ~BenchCase() {}
+	virtual void run() = 0;
+};
+
+void fillPattern(Graphics::Surface &surf) {
+	uint32 seed = 0x12345678;
+	for (int y = 0; y < surf.h; ++y) {
+		byte *row = (byte *)surf.getBasePtr(0, y);
+		for (int x = 0; x < surf.w * surf.format.bytesPerPixel; ++x) {
+			seed = seed * 1103515245 + 12345;
+			row[x] = (byte)(seed >> 16);
+		}
+	}
+}
+
+void report(const char *name, int w, int h, int bpp, BenchCase &bench) {
+	// Warm up caches and lookup tables
+	bench.run();
+
+	uint iterations = 0;
+	const double start = now();
+	double elapsed = 0;
+	do {
+		bench.run();
+		++iterations;
+		elapsed = now() - start;
+	} while (elapsed < g_minTime);
+
+	const double mpixels = (double)w * h * iterations / 1000000.0;
+	printf("%s,%d,%d,%d,%.2f\n", name, w, h, bpp, mpixels / elapsed);
+	fflush(stdout);
+}
+
+bool selected(const char *name) {
+	return !g_filter || strstr(name, g_filter);
+}
+
+/*
+ * Scalers
+ */
+
+struct ScalerInfo {
+	const char *name;
+	ScalerProc *proc;
+	int factor;  ///< Output size multiplier
+	int divisor; ///< Output size divisor, for fractional scalers
+};
+
+const ScalerInfo kScalers[] = {
+	{ "scaler_normal1x", Normal1x, 1, 1 },
+#ifdef USE_SCALERS
+	{ "scaler_normal2x", Normal2x, 2, 1 },
+	{ "scaler_normal3x", Normal3x, 3, 1 },
+	{ "scaler_normal1o5x", Normal1o5x, 3, 2 },
+	{ "scaler_2xsai", _2xSaI, 2, 1 },
+	{ "scaler_super2xsai", Super2xSaI, 2, 1 },
+	{ "scaler_supereagle", SuperEagle, 2, 1 },
+	{ "scaler_advmame2x", AdvMame2x, 2, 1 },
+	{ "scaler_advmame3x", AdvMame3x, 3, 1 },
+	{ "scaler_tv2x", TV2x, 2, 1 },
+	{ "scaler_dotmatrix", DotMatrix, 2, 1 },
+#ifdef USE_HQ_SCALERS
+	{ "scaler_hq2x", HQ2x, 2, 1 },
+	{ "scaler_hq3x", HQ3x, 3, 1 },
+#endif
+#endif
+	{ 0, 0, 0, 0 }
+};
+
+class ScalerBench : public BenchCase {
+public:
+	ScalerBench(const ScalerInfo &info, int w, int h) : _info(info), _w(w), _h(h) {
+		// Scalers read one pixel around the source area, so add a border
+		_src.create(w + 2, h + 2, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		fillPattern(_src);
+		_dst.create(w * info.factor / info.divisor, h * info.factor / info.divisor, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	~ScalerBench() {
+		_src.free();
+		_dst.free();
+	}
+
+	void run() {
+		_info.proc((const uint8 *)_src.getBasePtr(1, 1), _src.pitch, (uint8 *)_dst.getPixels(), _dst.pitch, _w, _h);
+	}
+
+private:
+	const ScalerInfo &_info;
+	int _w, _h;
+	Graphics::Surface _src, _dst;
+};
+
+/*
+ * Blitters
+ */
+
+class CopyRectBench : public BenchCase {
+public:
+	CopyRectBench(int w, int h, const Graphics::PixelFormat &format) {
+		_src.create(w, h, format);
+		fillPattern(_src);
+		_dst.create(w, h, format);
+	}
+
+	~CopyRectBench() {
+		_src.free();
+		_dst.free();
+	}
+
+	void run() {
+		_dst.copyRectToSurface(_src, 0, 0, Common::Rect(_src.w, _src.h));
+	}
+
+private:
+	Graphics::Surface _src, _dst;
+};
+
+class TransBlitBench : public BenchCase {
+public:
+	TransBlitBench(int w, int h, const Graphics::PixelFormat &format) : _dst(w, h, format) {
+		_src.create(w, h, format);
+		fillPattern(_src);
+	}
+
+	~TransBlitBench() {
+		_src.free();
+	}
+
+	void run() {
+		_dst.transBlitFrom(_src, 0);
+	}
+
+private:
+	Graphics::Surface _src;
+	Graphics::ManagedSurface _dst;
+};
+
+class AlphaBlitBench : public BenchCase {
+public:
+	AlphaBlitBench(int w, int h) {
+		_src.create(w, h, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillPattern(_src);
+		_dst.create(w, h, Graphics::TransparentSurface::getSupportedPixelFormat());
+	}
+
+	~AlphaBlitBench() {
+		_src.free();
+		_dst.free();
+	}
+
+	void run() {
+		_src.blit(_dst);
+	}
+
+private:
+	Graphics::TransparentSurface _src;
+	Graphics::Surface _dst;
+};
+
+class RotoscaleBench : public BenchCase {
+public:
+	RotoscaleBench(int w, int h) {
+		_src.create(w, h, Graphics::TransparentSurface::getSupportedPixelFormat());
+		fillPattern(_src);
+	}
+
+	~RotoscaleBench() {
+		_src.free();
+	}
+
+	void run() {
+		Graphics::TransformStruct transform(Graphics::kDefaultZoomX, Graphics::kDefaultZoomY, 30, _src.w / 2, _src.h / 2);
+		Graphics::TransparentSurface *result = _src.rotoscale(transform);
+		result->free();
+		delete result;
+	}
+
+private:
+	Graphics::TransparentSurface _src;
+};
+
+/*
+ * Conversions
+ */
+
+class CrossBlitBench : public BenchCase {
+public:
+	CrossBlitBench(int w, int h, const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat) {
+		_src.create(w, h, srcFormat);
+		fillPattern(_src);
+		_dst.create(w, h, dstFormat);
+	}
+
+	~CrossBlitBench() {
+		_src.free();
+		_dst.free();
+	}
+
+	void run() {
+		Graphics::crossBlit((byte *)_dst.getPixels(), (const byte *)_src.getPixels(), _dst.pitch, _src.pitch,
+		                    _src.w, _src.h, _dst.format, _src.format);
+	}
+
+private:
+	Graphics::Surface _src, _dst;
+};
+
+class YUVBench : public BenchCase {
+public:
+	YUVBench(int w, int h, const Graphics::PixelFormat &format) : _w(w), _h(h) {
+		_y = new byte[w * h];
+		_u = new byte[(w / 2) * (h / 2)];
+		_v = new byte[(w / 2) * (h / 2)];
+		for (int i = 0; i < w * h; ++i)
+			_y[i] = (byte)(i * 7);
+		for (int i = 0; i < (w / 2) * (h / 2); ++i) {
+			_u[i] = (byte)(i * 3);
+			_v[i] = (byte)(i * 5);
+		}
+		_dst.create(w, h, format);
+	}
+
+	~YUVBench() {
+		delete[] _y;
+		delete[] _u;
+		delete[] _v;
+		_dst.free();
+	}
+
+	void run() {
+		YUVToRGBMan.convert420(&_dst, Graphics::YUVToRGBManager::kScaleITU, _y, _u, _v, _w, _h, _w, _w / 2);
+	}
+
+private:
+	int _w, _h;
+	byte *_y, *_u, *_v;
+	Graphics::Surface _dst;
+};
+
+class ThumbnailBench : public BenchCase {
+public:
+	ThumbnailBench(int w, int h) {
+		_src.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+		fillPattern(_src);
+		for (int i = 0; i < 256 * 3; ++i)
+			_palette[i] = (byte)i;
+	}
+
+	~ThumbnailBench() {
+		_src.free();
+	}
+
+	void run() {
+		Graphics::Surface thumb;
+		createThumbnail(&thumb, (const uint8 *)_src.getPixels(), _src.w, _src.h, _palette);
+		thumb.free();
+	}
+
+private:
+	Graphics::Surface _src;
+	byte _palette[256 * 3];
+};
+
+void runAll() {
+	const Graphics::PixelFormat format565 = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	const Graphics::PixelFormat format8888 = Graphics::TransparentSurface::getSupportedPixelFormat();
+	const Graphics::PixelFormat formatCLUT8 = Graphics::PixelFormat::createFormatCLUT8();
+
+	InitScalers(565);
+
+	for (uint r = 0; r < ARRAYSIZE(kResolutions); ++r) {
+		const int w = kResolutions[r].w;
+		const int h = kResolutions[r].h;
+
+		for (const ScalerInfo *info = kScalers; info->name; ++info) {
+			if (selected(info->name)) {
+				ScalerBench bench(*info, w, h);
+				report(info->name, w, h, 16, bench);
+			}
+		}
+
+		if (selected("copyrect_8")) {
+			CopyRectBench bench(w, h, formatCLUT8);
+			report("copyrect_8", w, h, 8, bench);
+		}
+		if (selected("copyrect_16")) {
+			CopyRectBench bench(w, h, format565);
+			report("copyrect_16", w, h, 16, bench);
+		}
+		if (selected("copyrect_32")) {
+			CopyRectBench bench(w, h, format8888);
+			report("copyrect_32", w, h, 32, bench);
+		}
+		if (selected("transblit_8")) {
+			TransBlitBench bench(w, h, formatCLUT8);
+			report("transblit_8", w, h, 8, bench);
+		}
+		if (selected("transblit_16")) {
+			TransBlitBench bench(w, h, format565);
+			report("transblit_16", w, h, 16, bench);
+		}
+		if (selected("alphablit_32")) {
+			AlphaBlitBench bench(w, h);
+			report("alphablit_32", w, h, 32, bench);
+		}
+		if (selected("rotoscale_32")) {
+			RotoscaleBench bench(w, h);
+			report("rotoscale_32", w, h, 32, bench);
+		}
+		if (selected("crossblit_16_to_32")) {
+			CrossBlitBench bench(w, h, format8888, format565);
+			report("crossblit_16_to_32", w, h, 32, bench);
+		}
+		if (selected("crossblit_32_to_16")) {
+			CrossBlitBench bench(w, h, format565, format8888);
+			report("crossblit_32_to_16", w, h, 16, bench);
+		}
+		if (selected("yuv420_16")) {
+			YUVBench bench(w, h, format565);
+			report("yuv420_16", w, h, 16, bench);
+		}
+		if (selected("yuv420_32")) {
+			YUVBench bench(w, h, format8888);
+			report("yuv420_32", w, h, 32, bench);
+		}
+		if (selected("thumbnail_8")) {
+			ThumbnailBench bench(w, h);
+			report("thumbnail_8", w, h, 8, bench);
+		}
+	}
+
+	DestroyScalers();
+}
+
+} // End of anonymous namespace
+
+int main(int argc, char *argv[]) {
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--time") && i + 1 < argc) {
+			g_minTime = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+			g_filter = argv[++i];
+		} else {
+			printf("Usage: %s [--time seconds] [--filter name]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	printf("case,width,height,bpp,mpixels_per_second\n");
+	runAll();
+	return 0;
+}
@@ -0,0 +1,14 @@
+
+MODULE := devtools/gfxbench
+
+MODULE_OBJS := \
+	gfxbench.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := gfxbench
+
+# The benchmark links against the graphics code it measures
+TOOL_DEPS := graphics/libgraphics.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
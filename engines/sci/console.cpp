@@ -72,7 +72,8 @@ bool g_debug_track_mouse_clicks = false;
 static int parse_reg_t(EngineState *s, const char *str, reg_t *dest, bool mayBeValue);
 
 Console::Console(SciEngine *engine) : GUI::Debugger(),
-	_engine(engine), _debugState(engine->_debugState) {
+	_engine(engine), _debugState(engine->_debugState),
+	_vmStatsTime(g_system->getMillis()), _vmStatsSteps(0) {
 
 	assert(_engine);
 	assert(_engine->_gamestate);
@@ -80,6 +81,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	// Variables
 	registerVar("sleeptime_factor",	&g_debug_sleeptime_factor);
 	registerVar("gc_interval",		&engine->_gamestate->scriptGCInterval);
+	registerVar("decode_cache",		&engine->_gamestate->scriptDecodeCache);
 	registerVar("simulated_key",		&g_debug_simulated_key);
 	registerVar("track_mouse_clicks",	&g_debug_track_mouse_clicks);
 	// FIXME: This actually passes an enum type instead of an integer but no
@@ -114,6 +116,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
+	registerCmd("resource_stats",		WRAP_METHOD(Console, cmdResourceStats));
 	// Game
 	registerCmd("save_game",			WRAP_METHOD(Console, cmdSaveGame));
 	registerCmd("restore_game",		WRAP_METHOD(Console, cmdRestoreGame));
@@ -144,6 +147,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("cel_stats",          WRAP_METHOD(Console, cmdCelStats));
+	registerCmd("show_bands",         WRAP_METHOD(Console, cmdShowBands));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -157,6 +162,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -215,6 +221,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("script_load_stats",	WRAP_METHOD(Console, cmdScriptLoadStats));
+	registerCmd("vm_stats",			WRAP_METHOD(Console, cmdVMStats));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -326,6 +334,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("---------\n");
 	debugPrintf("sleeptime_factor: Factor to multiply with wait times in kWait()\n");
 	debugPrintf("gc_interval: Number of kernel calls in between garbage collections\n");
+	debugPrintf("decode_cache: Run scripts from decoded instructions instead of parsing them each time\n");
 	debugPrintf("simulated_key: Add a key with the specified scan code to the event list\n");
 	debugPrintf("track_mouse_clicks: Toggles mouse click tracking to the console\n");
 	debugPrintf("weak_validations: Turns some validation errors into warnings\n");
@@ -366,6 +375,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
+	debugPrintf(" resource_stats - Shows how well the resource cache and prefetching work\n");
 	debugPrintf("\n");
 	debugPrintf("Game:\n");
 	debugPrintf(" save_game - Saves the current game state to the hard disk\n");
@@ -392,6 +402,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" cel_stats - Shows how many cels were drawn, how long it took and how well cel data is cached (SCI2+)\n");
+	debugPrintf(" show_bands - Switches between tracking drawn areas in bands of screen rows and merging them rect by rect (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -404,6 +416,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows garbage collector pause statistics\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -446,6 +459,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" script_load_stats - Shows where the time spent loading scripts goes\n");
+	debugPrintf(" vm_stats - Shows selector lookup cache hit rates and VM throughput\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -1043,6 +1058,32 @@ bool Console::cmdHexgrep(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows resource cache hit, miss, eviction and prefetch counts.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	ResourceManager *resMan = _engine->getResMan();
+	const ResourceCacheStats &stats = resMan->getCacheStats();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Cache: %d of %d KB used, %d KB locked\n",
+	            resMan->getMemoryUsed() / 1024, resMan->getMaxMemory() / 1024, resMan->getMemoryLocked() / 1024);
+	debugPrintf("Requests: %u hits, %u misses (%u%% hit rate), %u evictions\n",
+	            stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0, stats.evictions);
+	debugPrintf("Prefetch: %u loaded, %u used, %u skipped for lack of space, %u queued\n",
+	            stats.prefetched, stats.prefetchHits, stats.prefetchSkipped, resMan->getPrefetchQueueSize());
+
+	if (argc == 2) {
+		resMan->resetCacheStats();
+		debugPrintf("Statistics reset\n");
+	}
+
+	return true;
+}
+
 bool Console::cmdVerifyScripts(int argc, const char **argv) {
 	if (getSciVersion() < SCI_VERSION_1_1) {
 		debugPrintf("This script check is only meant for SCI1.1-SCI3 games\n");
@@ -2027,6 +2068,83 @@ bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdCelStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not draw cels\n");
+		return true;
+	}
+
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows how many cels were drawn and how long it took.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const CelDrawStats &last = CelObj::_lastFrameDrawStats;
+	debugPrintf("Last frame: %u cels (%u scaled, %u compressed, %u remapped), %u pixels, %u ms\n",
+	            last.cels, last.scaledCels, last.compressedCels, last.remappedCels, last.pixels, last.drawTime);
+
+	const CelDrawStats &total = CelObj::_totalDrawStats;
+	if (total.frames) {
+		debugPrintf("Average over %u frames: %u cels, %u pixels, %u.%02u ms\n",
+		            total.frames, total.cels / total.frames, total.pixels / total.frames,
+		            total.drawTime / total.frames, total.drawTime * 100 / total.frames % 100);
+	}
+
+	const CelPixelCache *pixelCache = CelObj::_pixelCache;
+	if (pixelCache) {
+		const uint32 lookups = pixelCache->getHits() + pixelCache->getMisses();
+		debugPrintf("Decompressed cels: %u cached, %u of %u KB, %u hits, %u misses (%u%% hit rate), %u evicted, %u dropped with their resource\n",
+		            pixelCache->getEntryCount(), pixelCache->getMemory() / 1024, pixelCache->getMaxMemory() / 1024,
+		            pixelCache->getHits(), pixelCache->getMisses(), lookups ? pixelCache->getHits() * 100 / lookups : 0,
+		            pixelCache->getEvictions(), pixelCache->getPurges());
+	}
+
+	const CelScaler *scaler = CelObj::_scaler;
+	if (scaler) {
+		debugPrintf("Scale tables: %u hits, %u rebuilt\n", scaler->getHits(), scaler->getMisses());
+	}
+
+	if (argc == 2) {
+		CelObj::_totalDrawStats.reset();
+		if (CelObj::_pixelCache) {
+			CelObj::_pixelCache->resetStatistics();
+		}
+		if (CelObj::_scaler) {
+			CelObj::_scaler->resetStatistics();
+		}
+		debugPrintf("Statistics reset\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
+bool Console::cmdShowBands(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not draw cels\n");
+		return true;
+	}
+
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+		debugPrintf("Switches between tracking the areas drawn each frame in bands of screen rows, and merging them into the show list rect by rect.\n");
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		_engine->_gfxFrameout->setUseShowBands(!strcmp(argv[1], "on"));
+	}
+
+	debugPrintf("Show bands are %s\n", _engine->_gfxFrameout->getUseShowBands() ? "on" : "off");
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
 
 bool Console::cmdParseGrammar(int argc, const char **argv) {
 	debugPrintf("Parse grammar, in strict GNF:\n");
@@ -2546,6 +2664,29 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows garbage collector pause statistics.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	GCStatistics &stats = _engine->_gamestate->gcStats;
+
+	debugPrintf("Collections: %u, skipped: %u\n", stats.runs, stats.skipped);
+	debugPrintf("Pause time: total %u ms, average %u ms, longest %u ms, last %u ms\n",
+	            stats.totalTime, stats.runs ? stats.totalTime / stats.runs : 0, stats.maxTime, stats.lastTime);
+	debugPrintf("Freed entries: total %u, last collection %u\n", stats.freed, stats.lastFreed);
+	debugPrintf("Reachable addresses at last collection: %u\n", stats.lastReachable);
+
+	if (argc == 2) {
+		stats.reset();
+		debugPrintf("Statistics reset\n");
+	}
+
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
@@ -3025,6 +3166,69 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdScriptLoadStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows how much time was spent loading, patching and initializing scripts.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	SegManager *segMan = _engine->_gamestate->_segMan;
+	const ScriptLoadStats &loadStats = segMan->getScriptLoadStats();
+	const ScriptPatcherStats &patchStats = _engine->getScriptPatcher()->getStats();
+
+	debugPrintf("%u scripts instantiated\n", loadStats.loads);
+	debugPrintf("Loading: %u ms, of which %u ms patching\n", loadStats.loadTime, patchStats.time);
+	debugPrintf("Initializing locals, classes and objects: %u ms\n", loadStats.initTime);
+	debugPrintf("Patcher: %u scripts checked, %u bytes scanned, %u signatures verified, %u patches applied\n",
+	            patchStats.scripts, patchStats.bytesScanned, patchStats.candidates, patchStats.patchesApplied);
+
+	if (argc == 2) {
+		segMan->resetScriptLoadStats();
+		_engine->getScriptPatcher()->resetStats();
+		debugPrintf("Statistics reset\n");
+	}
+
+	return true;
+}
+
+bool Console::cmdVMStats(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+	const int steps = _engine->_gamestate->scriptStepCounter;
+	const uint32 time = g_system->getMillis();
+
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		debugPrintf("Shows selector lookup cache hit rates and VM throughput.\n");
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	// The step counter is reset when the game is restarted
+	if (steps < _vmStatsSteps)
+		_vmStatsSteps = 0;
+
+	const uint32 lookups = cache.getHits() + cache.getMisses();
+	debugPrintf("Selector lookups: %u, hits: %u (%u%%), misses: %u\n",
+	            lookups, cache.getHits(), lookups ? (uint)((uint64)cache.getHits() * 100 / lookups) : 0, cache.getMisses());
+	debugPrintf("Cache invalidations: %u\n", cache.getInvalidations());
+
+	const uint32 elapsed = time - _vmStatsTime;
+	const uint32 opcodes = steps - _vmStatsSteps;
+	debugPrintf("Executed %u opcodes in %u ms", opcodes, elapsed);
+	if (elapsed)
+		debugPrintf(" (%u opcodes/s)", (uint)((uint64)opcodes * 1000 / elapsed));
+	debugPrintf("\n");
+
+	if (argc == 2) {
+		cache.resetStatistics();
+		_vmStatsTime = time;
+		_vmStatsSteps = steps;
+		debugPrintf("Statistics reset\n");
+	}
+
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	int curScriptNr = -1;
 
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -181,6 +182,8 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 void run_gc(EngineState *s) {
 	SegManager *segMan = s->_segMan;
+	const uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -193,6 +196,7 @@ void run_gc(EngineState *s) {
 
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
+	s->gcStats.lastReachable = activeRefs->size();
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -214,6 +218,7 @@ void run_gc(EngineState *s) {
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
+					freed++;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -226,6 +231,19 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	// Remember the allocation count after the collection, as freeing a
+	// script may have unloaded it
+	s->gcAllocationCount = segMan->getAllocationCount();
+
+	GCStatistics &stats = s->gcStats;
+	stats.lastTime = g_system->getMillis() - startTime;
+	stats.totalTime += stats.lastTime;
+	stats.maxTime = MAX(stats.maxTime, stats.lastTime);
+	stats.lastFreed = freed;
+	stats.freed += freed;
+	stats.runs++;
+	debugC(kDebugLevelGC, "[GC] Freed %d entries in %d ms", freed, stats.lastTime);
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -235,4 +253,16 @@ void run_gc(EngineState *s) {
 #endif
 }
 
+void run_gc_if_needed(EngineState *s) {
+	// Without allocations, the heap cannot have grown since the last
+	// collection. Anything which has become unreachable in the meantime
+	// will be freed by the next collection after an allocation.
+	if (s->_segMan->getAllocationCount() == s->gcAllocationCount) {
+		s->gcStats.skipped++;
+		return;
+	}
+
+	run_gc(s);
+}
+
 } // End of namespace Sci
@@ -111,10 +111,20 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// A* set membership
+	bool inOpenSet;
+	bool inClosedSet;
+
+	// Index in the visibility cache, -1 if not cached
+	int index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		inOpenSet = false;
+		inClosedSet = false;
+		index = -1;
 	}
 };
 
@@ -236,6 +246,12 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+// A polygon edge, starting at vertex, with its bounding box
+struct PolygonEdge {
+	Vertex *vertex;
+	int16 left, top, right, bottom;
+};
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -250,6 +266,12 @@ struct PathfindingState {
 	// Total number of vertices
 	int vertices;
 
+	// All polygon edges, used for intersection tests
+	Common::Array<PolygonEdge> edges;
+
+	// Cached visibility for this polygon set, or NULL if not available
+	AvoidPathVisibility *_visibility;
+
 	// Point to prepend and append to final path
 	Common::Point *_prependPoint;
 	Common::Point *_appendPoint;
@@ -264,6 +286,7 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_visibility = NULL;
 	}
 
 	~PathfindingState() {
@@ -659,6 +682,51 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether the line between two vertices is free of obstacles.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if vertex is visible from vertex_cur
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	const Common::Point &a = vertex_cur->v;
+	const Common::Point &b = vertex->v;
+
+	// Edges outside of the bounding box of (a, b) can neither touch nor
+	// intersect it. This doesn't hold for a == b, as between() assumes
+	// that a != b.
+	const bool useBounds = (a != b);
+	const int16 left = MIN(a.x, b.x);
+	const int16 right = MAX(a.x, b.x);
+	const int16 top = MIN(a.y, b.y);
+	const int16 bottom = MAX(a.y, b.y);
+
+	// Check for intersecting edges
+	for (uint j = 0; j < s->edges.size(); j++) {
+		const PolygonEdge &polygonEdge = s->edges[j];
+
+		if (useBounds && (polygonEdge.right < left || polygonEdge.left > right ||
+		                  polygonEdge.bottom < top || polygonEdge.top > bottom))
+			continue;
+
+		Vertex *edge = polygonEdge.vertex;
+		if (between(a, b, edge->v)) {
+			// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+			if ((inside(a, edge)) || (inside(b, edge)))
+				return false;
+
+			// This edge won't properly intersect, so we continue
+			continue;
+		}
+
+		if (intersect_proper(a, b, edge->v, CLIST_NEXT(edge)->v))
+			return false;
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -668,6 +736,16 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	VertexList *visVerts = new VertexList();
 
+	// Visibility between polygon vertices may already be known from
+	// earlier calls with the same polygons
+	AvoidPathVisibility *visibility = (vertex_cur->index >= 0) ? s->_visibility : NULL;
+	uint32 *row = NULL;
+	bool rowDone = false;
+	if (visibility) {
+		row = &visibility->visible[vertex_cur->index * visibility->rowSize];
+		rowDone = visibility->rowDone[vertex_cur->index];
+	}
+
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
@@ -675,29 +753,27 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
+		bool visible;
+		if (row && vertex->index >= 0) {
+			const uint32 bit = 1 << (vertex->index & 31);
+			if (rowDone) {
+				visible = row[vertex->index >> 5] & bit;
+			} else {
+				visible = is_visible(s, vertex_cur, vertex);
+				if (visible)
+					row[vertex->index >> 5] |= bit;
 			}
+		} else {
+			visible = is_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
+	if (row)
+		visibility->rowDone[vertex_cur->index] = true;
+
 	return visVerts;
 }
 
@@ -1185,6 +1261,64 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Finds the cached visibility information for the polygons of a pathfinding
+ * state, or creates an empty entry for them. Also numbers the vertices of
+ * the polygons accordingly.
+ * Parameters: (EngineState *) s: The game state
+ *             (PathfindingState *) pf_s: The pathfinding state
+ * Returns   : (AvoidPathVisibility *) The visibility information, or NULL
+ *                                     if there are too many vertices
+ */
+static AvoidPathVisibility *lookup_visibility(EngineState *s, PathfindingState *pf_s) {
+	const uint kMaxEntries = 4;
+	const uint kMaxVertices = 1024;
+
+	Common::Array<int16> key;
+	uint vertices = 0;
+
+	for (PolygonList::iterator it = pf_s->polygons.begin(); it != pf_s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		key.push_back(polygon->type);
+		key.push_back(polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = vertices++;
+			key.push_back(vertex->v.x);
+			key.push_back(vertex->v.y);
+		}
+	}
+
+	if (vertices > kMaxVertices)
+		return NULL;
+
+	Common::List<AvoidPathVisibility> &cache = s->_avoidPathCache;
+	for (Common::List<AvoidPathVisibility>::iterator it = cache.begin(); it != cache.end(); ++it) {
+		if (it->polygons == key) {
+			// Move to the front
+			if (it != cache.begin()) {
+				cache.push_front(*it);
+				cache.erase(it);
+			}
+			debugC(kDebugLevelAvoidPath, "[avoidpath] Using cached visibility for %d vertices", vertices);
+			return &cache.front();
+		}
+	}
+
+	if (cache.size() >= kMaxEntries)
+		cache.pop_back();
+
+	cache.push_front(AvoidPathVisibility());
+	AvoidPathVisibility &visibility = cache.front();
+	visibility.polygons = key;
+	visibility.vertices = vertices;
+	visibility.rowSize = (vertices + 31) / 32;
+	visibility.visible.resize(vertices * visibility.rowSize);
+	visibility.rowDone.resize(vertices);
+	return &visibility;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1276,6 +1410,8 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	pf_s->_visibility = lookup_visibility(s, pf_s);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1283,6 +1419,12 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_start;
 	delete new_end;
 
+	// If a point was merged into an edge, the polygons no longer match the
+	// cached ones
+	if ((pf_s->vertex_start->index < 0 && VERTEX_HAS_EDGES(pf_s->vertex_start)) ||
+		(pf_s->vertex_end->index < 0 && VERTEX_HAS_EDGES(pf_s->vertex_end)))
+		pf_s->_visibility = NULL;
+
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
 
@@ -1299,6 +1441,21 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 
 	pf_s->vertices = count;
 
+	for (int i = 0; i < count; i++) {
+		Vertex *vertex = pf_s->vertex_index[i];
+		if (VERTEX_HAS_EDGES(vertex)) {
+			const Common::Point &p1 = vertex->v;
+			const Common::Point &p2 = CLIST_NEXT(vertex)->v;
+			PolygonEdge edge;
+			edge.vertex = vertex;
+			edge.left = MIN(p1.x, p2.x);
+			edge.right = MAX(p1.x, p2.x);
+			edge.top = MIN(p1.y, p2.y);
+			edge.bottom = MAX(p1.y, p2.y);
+			pf_s->edges.push_back(edge);
+		}
+	}
+
 	return pf_s;
 }
 
@@ -1310,13 +1467,12 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
-
-	// The remaining vertices
+	// The remaining vertices. Vertices of which the shortest path is known
+	// are flagged as being in the closed set.
 	VertexList openSet;
 
 	openSet.push_front(s->vertex_start);
+	s->vertex_start->inOpenSet = true;
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
 
@@ -1342,8 +1498,9 @@ static void AStar(PathfindingState *s) {
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
 		openSet.erase(vertex_min_it);
+		vertex_min->inOpenSet = false;
+		vertex_min->inClosedSet = true;
 
 		VertexList *visVerts = visible_vertices(s, vertex_min);
 
@@ -1351,11 +1508,13 @@ static void AStar(PathfindingState *s) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->inClosedSet)
 				continue;
 
-			if (!openSet.contains(vertex))
+			if (!vertex->inOpenSet) {
 				openSet.push_front(vertex);
+				vertex->inOpenSet = true;
+			}
 
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
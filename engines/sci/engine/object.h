@@ -261,6 +261,7 @@ public:
 	void initSuperClass(SegManager *segMan, reg_t addr);
 	bool initBaseObject(SegManager *segMan, reg_t addr, bool doInitSuperClass = true);
 	void syncBaseObject(const byte *ptr) { _baseObj = ptr; }
+	const byte *getBaseObject() const { return _baseObj; }
 
 	bool mustSetViewVisibleSci3(int selector) const { return _mustSetViewVisible[selector/32]; }
 
@@ -299,6 +299,9 @@ void SegManager::saveLoadWithSerializer(Common::Serializer &s) {
 			}
 		}
 	}
+
+	if (s.isLoading())
+		_selectorLookupCache.invalidate();
 }
 
 
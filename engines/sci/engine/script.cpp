@@ -70,6 +70,27 @@ void Script::freeScript() {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	_instructions.clear();
+	_instructionIndex.clear();
+}
+
+const DecodedInstruction &Script::decodeInstruction(uint32 offset) {
+	DecodedInstruction instruction;
+	instruction.length = readPMachineInstruction(_buf + offset, instruction.extOpcode, instruction.params);
+
+	// The index can only address 65535 instructions, which is more than any
+	// script contains. Should a script ever exceed it, keep decoding the
+	// remaining instructions into a spare slot every time they are run.
+	if (_instructions.size() >= 0xFFFF) {
+		_instructions.resize(0x10000);
+		_instructions[0xFFFF] = instruction;
+		return _instructions[0xFFFF];
+	}
+
+	_instructions.push_back(instruction);
+	_instructionIndex[offset] = _instructions.size();
+	return _instructions.back();
 }
 
 enum {
@@ -160,6 +181,9 @@ void Script::load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptP
 	// Check scripts (+ possibly SCI 1.1 heap) for matching signatures and patch those, if found
 	scriptPatcher->processScript(_nr, _buf, _bufSize);
 
+	// Instructions are decoded on demand, see getInstruction()
+	_instructionIndex.resize(_bufSize);
+
 	if (getSciVersion() <= SCI_VERSION_1_LATE) {
 		_exportTable = (const uint16 *)findBlockSCI0(SCI_OBJ_EXPORTS);
 		if (_exportTable) {
@@ -64,6 +64,15 @@ struct offsetLookupArrayEntry {
 
 typedef Common::Array<offsetLookupArrayEntry> offsetLookupArrayType;
 
+/**
+ * A PMachine instruction, as returned by readPMachineInstruction().
+ */
+struct DecodedInstruction {
+	int16 params[4];  ///< the instruction's parameters
+	uint16 length;    ///< length of the instruction in bytes, including parameters
+	byte extOpcode;   ///< "extended" opcode, the lower bit selects the operand size
+};
+
 class Script : public SegmentObj {
 private:
 	int _nr; /**< Script number */
@@ -100,6 +109,14 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Instructions of this script that have been executed so far, and for
+	 * every offset in the script buffer the index of the instruction at
+	 * that offset plus one, or 0 if it has not been decoded yet.
+	 */
+	Common::Array<DecodedInstruction> _instructions;
+	Common::Array<uint16> _instructionIndex;
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -109,6 +126,19 @@ public:
 	uint32 getBufSize() const { return _bufSize; }
 	const byte *getBuf(uint offset = 0) const { return _buf + offset; }
 
+	/**
+	 * Returns the instruction at the given offset of the script buffer.
+	 * Instructions are decoded the first time they are requested and kept
+	 * until the script is freed, so that the VM does not have to parse the
+	 * operands of an instruction every time it is executed.
+	 */
+	const DecodedInstruction &getInstruction(uint32 offset) {
+		const uint16 index = _instructionIndex[offset];
+		if (index)
+			return _instructions[index - 1];
+		return decodeInstruction(offset);
+	}
+
 	int getScriptNumber() const { return _nr; }
 	SegmentId getLocalsSegment() const { return _localsSegment; }
 	reg_t *getLocalsBegin() { return _localsBlock ? _localsBlock->_locals.begin() : NULL; }
@@ -124,6 +154,9 @@ public:
 	void freeScript();
 	void load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptPatcher);
 
+	/** Decodes the instruction at the given offset and adds it to the instruction cache. */
+	const DecodedInstruction &decodeInstruction(uint32 offset);
+
 	virtual bool isValidOffset(uint16 offset) const;
 	virtual SegmentRef dereference(reg_t pointer);
 	virtual reg_t findCanonicAddress(SegManager *segMan, reg_t sub_addr) const;
@@ -27,6 +27,8 @@
 #include "sci/engine/features.h"
 #include "sci/engine/script_patches.h"
 
+#include "common/algorithm.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Sci {
@@ -4759,7 +4761,7 @@ ScriptPatcher::~ScriptPatcher() {
 }
 
 // will actually patch previously found signature area
-void ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, byte *scriptData, const uint32 scriptSize, int32 signatureOffset) {
+int32 ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, byte *scriptData, const uint32 scriptSize, int32 signatureOffset) {
 	const uint16 *patchData = patchEntry->patchData;
 	byte orgData[PATCH_VALUELIMIT];
 	int32 offset = signatureOffset;
@@ -4848,6 +4850,8 @@ void ScriptPatcher::applyPatch(const SciScriptPatcherEntry *patchEntry, byte *sc
 		patchData++;
 		patchWord = *patchData;
 	}
+
+	return offset;
 }
 
 bool ScriptPatcher::verifySignature(uint32 byteOffset, const uint16 *signatureData, const char *signatureDescription, const byte *scriptData, const uint32 scriptSize) {
@@ -4959,8 +4963,107 @@ int32 ScriptPatcher::findSignature(uint32 magicDWord, int magicOffset, const uin
 	return -1;
 }
 
-int32 ScriptPatcher::findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const byte *scriptData, const uint32 scriptSize) {
-	return findSignature(runtimeEntry->magicDWord, runtimeEntry->magicOffset, patchEntry->signatureData, patchEntry->description, scriptData, scriptSize);
+// Gives the same result as a full findSignature scan, as long as magicDWordOffsets holds all offsets of the magic DWORD
+//  in the script data before any of patchedRanges were patched
+int32 ScriptPatcher::findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const OffsetList &magicDWordOffsets, const PatchedRangeList &patchedRanges, const byte *scriptData, const uint32 scriptSize) {
+	const uint32 searchLimit = scriptSize - 3;
+	const OffsetList *offsets = &magicDWordOffsets;
+	OffsetList mergedOffsets;
+
+	if (!patchedRanges.empty()) {
+		// A patch may have created new occurrences of the magic DWORD, which can only start at most 3 bytes before
+		//  the patched bytes
+		mergedOffsets = magicDWordOffsets;
+		for (PatchedRangeList::const_iterator range = patchedRanges.begin(); range != patchedRanges.end(); ++range) {
+			const uint32 end = MIN(range->end, searchLimit);
+			for (uint32 offset = range->start >= 3 ? range->start - 3 : 0; offset < end; offset++)
+				mergedOffsets.push_back(offset);
+		}
+		Common::sort(mergedOffsets.begin(), mergedOffsets.end());
+		offsets = &mergedOffsets;
+	}
+
+	uint32 previousOffset = 0xFFFFFFFF;
+	for (OffsetList::const_iterator it = offsets->begin(); it != offsets->end(); ++it) {
+		const uint32 DWordOffset = *it;
+		if (DWordOffset == previousOffset)
+			continue;
+		previousOffset = DWordOffset;
+
+		// magic DWORD may have been overwritten by a patch
+		if (runtimeEntry->magicDWord != READ_UINT32(scriptData + DWordOffset))
+			continue;
+
+		_stats.candidates++;
+		const uint32 offset = DWordOffset + runtimeEntry->magicOffset;
+		if (verifySignature(offset, patchEntry->signatureData, patchEntry->description, scriptData, scriptSize))
+			return offset;
+	}
+	// nothing found
+	return -1;
+}
+
+void ScriptPatcher::patchScript(const SciScriptPatcherEntry *patchTable, const Common::Array<uint> &entryIndexes, uint16 scriptNr, byte *scriptData, const uint32 scriptSize) {
+	if (scriptSize < 4) // we need to find a DWORD, so less than 4 bytes is not okay
+		return;
+
+	// Filter on the first byte of the magic DWORDs, so that most script offsets are rejected by a single lookup
+	Common::Array<uint> activeEntries;
+	uint32 firstByteFilter[256 / 32];
+	memset(firstByteFilter, 0, sizeof(firstByteFilter));
+
+	for (uint i = 0; i < entryIndexes.size(); i++) {
+		if (!_runtimeTable[entryIndexes[i]].active)
+			continue;
+		activeEntries.push_back(entryIndexes[i]);
+
+		// magicDWord is in platform-specific BE/LE form, so its first byte in memory is the first byte in the script
+		byte magicDWord[4];
+		WRITE_UINT32(magicDWord, _runtimeTable[entryIndexes[i]].magicDWord);
+		firstByteFilter[magicDWord[0] >> 5] |= 1 << (magicDWord[0] & 31);
+	}
+
+	if (activeEntries.empty())
+		return;
+
+	// Find the offsets of the magic DWORDs of all signatures in one pass
+	Common::Array<OffsetList> magicDWordOffsets;
+	magicDWordOffsets.resize(activeEntries.size());
+	const uint32 searchLimit = scriptSize - 3;
+	for (uint32 DWordOffset = 0; DWordOffset < searchLimit; DWordOffset++) {
+		const byte firstByte = scriptData[DWordOffset];
+		if (!(firstByteFilter[firstByte >> 5] & (1 << (firstByte & 31))))
+			continue;
+
+		const uint32 DWord = READ_UINT32(scriptData + DWordOffset);
+		for (uint i = 0; i < activeEntries.size(); i++) {
+			if (DWord == _runtimeTable[activeEntries[i]].magicDWord)
+				magicDWordOffsets[i].push_back(DWordOffset);
+		}
+	}
+	_stats.bytesScanned += scriptSize;
+
+	// Patches are applied in table order, and later signatures are matched against the already patched data
+	PatchedRangeList patchedRanges;
+	for (uint i = 0; i < activeEntries.size(); i++) {
+		const SciScriptPatcherEntry *curEntry = &patchTable[activeEntries[i]];
+		const SciScriptPatcherRuntimeEntry *curRuntimeEntry = &_runtimeTable[activeEntries[i]];
+		int32 foundOffset = 0;
+		int16 applyCount = curEntry->applyCount;
+		do {
+			foundOffset = findSignature(curEntry, curRuntimeEntry, magicDWordOffsets[i], patchedRanges, scriptData, scriptSize);
+			if (foundOffset != -1) {
+				// found, so apply the patch
+				debugC(kDebugLevelScriptPatcher, "Script-Patcher: '%s' on script %d offset %d", curEntry->description, scriptNr, foundOffset);
+				PatchedRange range;
+				range.start = foundOffset;
+				range.end = applyPatch(curEntry, scriptData, scriptSize, foundOffset);
+				patchedRanges.push_back(range);
+				_stats.patchesApplied++;
+			}
+			applyCount--;
+		} while ((foundOffset != -1) && (applyCount));
+	}
 }
 
 // Attention: Magic DWord is returned using platform specific byte order. This is done on purpose for performance.
@@ -5122,6 +5225,9 @@ void ScriptPatcher::initSignature(const SciScriptPatcherEntry *patchTable) {
 		// We verify the patch data
 		calculateMagicDWordAndVerify(curEntry->description, curEntry->patchData, false, curRuntimeEntry->magicDWord, curRuntimeEntry->magicOffset);
 
+		// Remember the entry for its script, so that script loads only need to look at their own entries
+		_scriptEntries[curEntry->scriptNr].push_back(curEntry - patchTable);
+
 		curEntry++; curRuntimeEntry++;
 	}
 }
@@ -5149,8 +5255,6 @@ void ScriptPatcher::enablePatch(const SciScriptPatcherEntry *patchTable, const c
 
 void ScriptPatcher::processScript(uint16 scriptNr, byte *scriptData, const uint32 scriptSize) {
 	const SciScriptPatcherEntry *signatureTable = NULL;
-	const SciScriptPatcherEntry *curEntry = NULL;
-	SciScriptPatcherRuntimeEntry *curRuntimeEntry = NULL;
 	const Sci::SciGameId gameId = g_sci->getGameId();
 
 	switch (gameId) {
@@ -5308,25 +5412,14 @@ void ScriptPatcher::processScript(uint16 scriptNr, byte *scriptData, const uint3
 			}
 		}
 
-		curEntry = signatureTable;
-		curRuntimeEntry = _runtimeTable;
-
-		while (curEntry->signatureData) {
-			if ((scriptNr == curEntry->scriptNr) && (curRuntimeEntry->active)) {
-				int32 foundOffset = 0;
-				int16 applyCount = curEntry->applyCount;
-				do {
-					foundOffset = findSignature(curEntry, curRuntimeEntry, scriptData, scriptSize);
-					if (foundOffset != -1) {
-						// found, so apply the patch
-						debugC(kDebugLevelScriptPatcher, "Script-Patcher: '%s' on script %d offset %d", curEntry->description, scriptNr, foundOffset);
-						applyPatch(curEntry, scriptData, scriptSize, foundOffset);
-					}
-					applyCount--;
-				} while ((foundOffset != -1) && (applyCount));
-			}
-			curEntry++; curRuntimeEntry++;
-		}
+		const uint32 startTime = g_system->getMillis();
+		_stats.scripts++;
+
+		ScriptEntryMap::const_iterator scriptEntries = _scriptEntries.find(scriptNr);
+		if (scriptEntries != _scriptEntries.end())
+			patchScript(signatureTable, scriptEntries->_value, scriptNr, scriptData, scriptSize);
+
+		_stats.time += g_system->getMillis() - startTime;
 	}
 }
 
@@ -23,6 +23,8 @@
 #ifndef SCI_ENGINE_SCRIPT_PATCHES_H
 #define SCI_ENGINE_SCRIPT_PATCHES_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "sci/sci.h"
 
 namespace Sci {
@@ -82,6 +84,24 @@ struct SciScriptPatcherRuntimeEntry {
 	int magicOffset;
 };
 
+/**
+ * Counters for the work done by the script patcher, shown by the
+ * `script_load_stats` console command
+ */
+struct ScriptPatcherStats {
+	uint32 scripts;        // Scripts checked for signatures
+	uint32 bytesScanned;   // Bytes of scripts which have signatures
+	uint32 candidates;     // Magic DWORD matches whose signature was verified
+	uint32 patchesApplied;
+	uint32 time;           // Total time spent, in milliseconds
+
+	ScriptPatcherStats() { reset(); }
+
+	void reset() {
+		scripts = bytesScanned = candidates = patchesApplied = time = 0;
+	}
+};
+
 /**
  * ScriptPatcher class, handles on-the-fly patching of script data
  */
@@ -104,23 +124,43 @@ public:
 	// returns -1 in case it was not found or an offset to the matching data
 	int32 findSignature(uint32 magicDWord, int magicOffset, const uint16 *signatureData, const char *patchDescription, const byte *scriptData, const uint32 scriptSize);
 
+	const ScriptPatcherStats &getStats() const { return _stats; }
+	void resetStats() { _stats.reset(); }
+
 private:
+	// A range of script data which was overwritten by a patch
+	struct PatchedRange {
+		uint32 start;
+		uint32 end;
+	};
+
+	typedef Common::Array<uint32> OffsetList;
+	typedef Common::Array<PatchedRange> PatchedRangeList;
+	typedef Common::HashMap<uint16, Common::Array<uint> > ScriptEntryMap;
+
 	// Initializes a patch table and creates run time information for it (for enabling/disabling), also calculates magic DWORD)
 	void initSignature(const SciScriptPatcherEntry *patchTable);
 
 	// Enables a patch inside the patch table (used for optional patches like CD+Text support for KQ6 & LB2)
 	void enablePatch(const SciScriptPatcherEntry *patchTable, const char *searchDescription);
 
-	// Searches for a given signature entry inside script data
+	// Finds and applies all active patches of the given entries in a single pass over the script data
+	void patchScript(const SciScriptPatcherEntry *patchTable, const Common::Array<uint> &entryIndexes, uint16 scriptNr, byte *scriptData, const uint32 scriptSize);
+
+	// Searches for a given signature entry inside script data, checking only the given offsets of its magic DWORD
+	//  and the parts of the script which were patched since those offsets were collected
 	// returns -1 in case it was not found or an offset to the matching data
-	int32 findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const byte *scriptData, const uint32 scriptSize);
+	int32 findSignature(const SciScriptPatcherEntry *patchEntry, const SciScriptPatcherRuntimeEntry *runtimeEntry, const OffsetList &magicDWordOffsets, const PatchedRangeList &patchedRanges, const byte *scriptData, const uint32 scriptSize);
 
 	// Applies a patch to a given script + offset (overwrites parts)
-	void applyPatch(const SciScriptPatcherEntry *patchEntry, byte *scriptData, const uint32 scriptSize, int32 signatureOffset);
+	// Returns the offset following the last byte written
+	int32 applyPatch(const SciScriptPatcherEntry *patchEntry, byte *scriptData, const uint32 scriptSize, int32 signatureOffset);
 
 	Selector *_selectorIdTable;
 	SciScriptPatcherRuntimeEntry *_runtimeTable;
+	ScriptEntryMap _scriptEntries; // Indexes of the patch table entries for each script
 	bool _isMacSci11;
+	ScriptPatcherStats _stats;
 };
 
 } // End of namespace Sci
@@ -20,6 +20,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "sci/sci.h"
 #include "sci/engine/seg_manager.h"
 #include "sci/engine/state.h"
@@ -32,6 +34,8 @@ SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
 	: _resMan(resMan), _scriptPatcher(scriptPatcher) {
 	_heap.push_back(0);
 
+	_allocationCount = 0;
+
 	_clonesSegId = 0;
 	_listsSegId = 0;
 	_nodesSegId = 0;
@@ -77,6 +81,9 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	_selectorLookupCache.invalidate();
+	_allocationCount++;
 }
 
 void SegManager::initSysStrings() {
@@ -116,6 +123,8 @@ SegmentObj *SegManager::allocSegment(SegmentObj *mem, SegmentId *segid) {
 	if (!mem)
 		error("SegManager: invalid mobj");
 
+	_allocationCount++;
+
 	// ... and put it into the (formerly) free segment.
 	if (id >= (int)_heap.size()) {
 		assert(id == (int)_heap.size());
@@ -164,6 +173,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		_selectorLookupCache.invalidate();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -401,6 +411,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	table = (HunkTable *)_heap[_hunksSegId];
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	reg_t addr = make_reg(_hunksSegId, offset);
 	Hunk *h = &table->at(offset);
@@ -436,6 +447,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	*addr = make_reg(_clonesSegId, offset);
 	return &table->at(offset);
@@ -450,6 +462,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	table = (ListTable *)_heap[_listsSegId];
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	*addr = make_reg(_listsSegId, offset);
 	return &table->at(offset);
@@ -464,6 +477,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	table = (NodeTable *)_heap[_nodesSegId];
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	*addr = make_reg(_nodesSegId, offset);
 	return &table->at(offset);
@@ -870,6 +884,7 @@ SciArray *SegManager::allocateArray(SciArrayType type, uint16 size, reg_t *addr)
 		table = (ArrayTable *)_heap[_arraysSegId];
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	*addr = make_reg(_arraysSegId, offset);
 
@@ -926,6 +941,7 @@ SciBitmap *SegManager::allocateBitmap(reg_t *addr, const int16 width, const int1
 	}
 
 	offset = table->allocEntry();
+	_allocationCount++;
 
 	*addr = make_reg(_bitmapSegId, offset);
 	SciBitmap &bitmap = table->at(offset);
@@ -1018,11 +1034,20 @@ int SegManager::instantiateScript(int scriptNum) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	const uint32 startTime = g_system->getMillis();
 	scr->load(scriptNum, _resMan, _scriptPatcher);
+	const uint32 loadedTime = g_system->getMillis();
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
 	scr->initializeObjects(this, segmentId);
 
+	_scriptLoadStats.loads++;
+	_scriptLoadStats.loadTime += loadedTime - startTime;
+	_scriptLoadStats.initTime += g_system->getMillis() - loadedTime;
+
+	// The new script may reuse the memory of a freed one
+	_selectorLookupCache.invalidate();
+
 	return segmentId;
 }
 
@@ -1053,6 +1078,7 @@ void SegManager::uninstantiateScript(int script_nr) {
 	if (!scr->getLockers()) {
 		// The actual script deletion seems to be done by SCI scripts themselves
 		scr->markDeleted();
+		_allocationCount++; // the script may be freed by the next GC
 		debugC(kDebugLevelScripts, "Unloaded script 0x%x.", script_nr);
 	}
 }
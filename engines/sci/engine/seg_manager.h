@@ -46,6 +46,22 @@ enum ScriptLoadType {
 
 class Script;
 
+/**
+ * Counters for the time spent instantiating scripts, shown by the
+ * `script_load_stats` console command.
+ */
+struct ScriptLoadStats {
+	uint32 loads;    ///< Number of scripts instantiated
+	uint32 loadTime; ///< Time spent reading and patching script data, in ms
+	uint32 initTime; ///< Time spent initializing locals, classes and objects, in ms
+
+	ScriptLoadStats() { reset(); }
+
+	void reset() {
+		loads = loadTime = initTime = 0;
+	}
+};
+
 class SegManager : public Common::Serializable {
 	friend class Console;
 public:
@@ -451,6 +467,19 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Returns the number of entries and segments allocated and scripts
+	 * unloaded so far. As long as it does not change, the heap has not
+	 * grown, so a garbage collection can be postponed.
+	 */
+	uint32 getAllocationCount() const { return _allocationCount; }
+
+	/** Returns the cache used by lookupSelector(). */
+	SelectorLookupCache &getSelectorLookupCache() { return _selectorLookupCache; }
+
+	const ScriptLoadStats &getScriptLoadStats() const { return _scriptLoadStats; }
+	void resetScriptLoadStats() { _scriptLoadStats.reset(); }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -460,6 +489,10 @@ private:
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
 
+	SelectorLookupCache _selectorLookupCache;
+	uint32 _allocationCount; ///< see getAllocationCount()
+	ScriptLoadStats _scriptLoadStats;
+
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
 	SegmentId _listsSegId; ///< ID of the (a) list segment
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
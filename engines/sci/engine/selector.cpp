@@ -23,6 +23,7 @@
 #include "sci/sci.h"
 #include "sci/engine/features.h"
 #include "sci/engine/kernel.h"
+#include "sci/engine/seg_manager.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 
@@ -300,22 +301,41 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
 	}
 
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	SelectorType type;
+	reg_t func;
+
+	if (cache.lookup(obj, selectorId, type, index, func)) {
+		if (type == kSelectorVariable && varp) {
+			varp->obj = obj_location;
+			varp->varindex = index;
+		} else if (type == kSelectorMethod && fptr) {
+			*fptr = func;
+		}
+		return type;
+	}
+
 	index = obj->locateVarSelector(segMan, selectorId);
 
 	if (index >= 0) {
 		// Found it as a variable
+		cache.store(obj, selectorId, kSelectorVariable, index, NULL_REG);
 		if (varp) {
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
 		return kSelectorVariable;
 	} else {
+		const Object *origObj = obj;
+
 		// Check if it's a method, with recursive lookup in superclasses
 		while (obj) {
 			index = obj->funcSelectorPosition(selectorId);
 			if (index >= 0) {
+				func = obj->getFunction(index);
+				cache.store(origObj, selectorId, kSelectorMethod, -1, func);
 				if (fptr)
-					*fptr = obj->getFunction(index);
+					*fptr = func;
 
 				return kSelectorMethod;
 			} else {
@@ -323,6 +343,7 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			}
 		}
 
+		cache.store(origObj, selectorId, kSelectorNone, -1, NULL_REG);
 		return kSelectorNone;
 	}
 
@@ -330,4 +351,64 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 //	return _lookupSelector_function(segMan, obj, selectorId, fptr);
 }
 
+SelectorLookupCache::SelectorLookupCache() {
+	invalidate();
+	resetStatistics();
+}
+
+uint SelectorLookupCache::hash(const byte *baseObj, Selector selectorId) const {
+	// Objects are at least a few dozen bytes apart, so the low bits of the
+	// address carry little information
+	const uint32 addr = (uint32)(size_t)baseObj;
+	return ((addr >> 3) ^ (addr >> 11) ^ ((uint32)selectorId * 0x9E37)) & (kCacheSize - 1);
+}
+
+bool SelectorLookupCache::lookup(const Object *obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func) {
+	const byte *baseObj = obj->getBaseObject();
+	if (baseObj) {
+		const Entry &entry = _entries[hash(baseObj, selectorId)];
+		if (entry.baseObj == baseObj && entry.selector == selectorId &&
+			entry.species == obj->getSpeciesSelector() &&
+			entry.superClass == obj->getSuperClassSelector() &&
+			entry.isClass == obj->isClass()) {
+			type = entry.type;
+			varIndex = entry.varIndex;
+			func = entry.func;
+			++_hits;
+			return true;
+		}
+	}
+
+	++_misses;
+	return false;
+}
+
+void SelectorLookupCache::store(const Object *obj, Selector selectorId, SelectorType type, int varIndex, reg_t func) {
+	const byte *baseObj = obj->getBaseObject();
+	if (!baseObj)
+		return;
+
+	Entry &entry = _entries[hash(baseObj, selectorId)];
+	entry.baseObj = baseObj;
+	entry.species = obj->getSpeciesSelector();
+	entry.superClass = obj->getSuperClassSelector();
+	entry.selector = selectorId;
+	entry.isClass = obj->isClass();
+	entry.type = type;
+	entry.varIndex = varIndex;
+	entry.func = func;
+}
+
+void SelectorLookupCache::invalidate() {
+	for (uint i = 0; i < kCacheSize; ++i)
+		_entries[i].baseObj = 0;
+	++_invalidations;
+}
+
+void SelectorLookupCache::resetStatistics() {
+	_hits = 0;
+	_misses = 0;
+	_invalidations = 0;
+}
+
 } // End of namespace Sci
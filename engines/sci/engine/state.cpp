@@ -103,6 +103,7 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcAllocationCount = 0;
 
 	_throttleCounter = 0;
 	_throttleLastTime = 0;
@@ -118,6 +119,7 @@ void EngineState::reset(bool isRestoring) {
 
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
+	scriptDecodeCache = true;
 
 	_videoState.reset();
 	_syncedAudioOptions = false;
@@ -110,6 +110,42 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Garbage collector statistics, shown by the gc_stats console command.
+ * Times are in milliseconds.
+ */
+struct GCStatistics {
+	uint32 runs; ///< Number of collections
+	uint32 skipped; ///< Number of periodic collections skipped, as the heap had not grown
+	uint32 freed; ///< Number of entries freed by all collections
+	uint32 totalTime;
+	uint32 maxTime;
+	uint32 lastTime;
+	uint32 lastFreed; ///< Number of entries freed by the last collection
+	uint32 lastReachable; ///< Number of addresses found reachable by the last collection
+
+	GCStatistics() { reset(); }
+
+	void reset() {
+		runs = skipped = freed = 0;
+		totalTime = maxTime = lastTime = 0;
+		lastFreed = lastReachable = 0;
+	}
+};
+
+/**
+ * Visibility between the vertices of a polygon set, as computed by
+ * kAvoidPath. Scripts usually pass the same polygons for every path they
+ * request in a room, so this is kept for the last few polygon sets.
+ */
+struct AvoidPathVisibility {
+	Common::Array<int16> polygons; ///< types, sizes and points of the polygons
+	uint vertices; ///< number of polygon vertices
+	uint rowSize; ///< size of a row of the visibility matrix, in words
+	Common::Array<uint32> visible; ///< one bit per pair of vertices
+	Common::Array<bool> rowDone; ///< whether the row of a vertex has been computed
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -185,6 +221,7 @@ public:
 
 	int scriptStepCounter; // Counts the number of steps executed
 	int scriptGCInterval; // Number of steps in between gcs
+	bool scriptDecodeCache; // Execute instructions from the per-script decode cache
 
 	uint16 currentRoomNumber() const;
 	void setRoomNumber(uint16 roomNumber);
@@ -201,6 +238,10 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	uint32 gcAllocationCount; /**< Allocation count of the SegManager at the last gc */
+	GCStatistics gcStats;
+
+	Common::List<AvoidPathVisibility> _avoidPathCache; /**< Most recently used first */
 
 	MessageState *_msgState;
 
@@ -197,6 +197,11 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 		if (type == VAR_TEMP && value.getSegment() == 0xffff)
 			value.setSegment(0);
 
+		// A new room number is set a game cycle before the room is actually
+		// entered, so use the time in between to load the room's resources
+		if (type == VAR_GLOBAL && index == kGlobalVarNewRoomNo && value != s->variables[type][index] && value.isNumber())
+			g_sci->getResMan()->queueRoomPrefetch(value.toUint16());
+
 		s->variables[type][index] = value;
 
 #ifdef ENABLE_SCI32
@@ -693,7 +698,17 @@ void run_vm(EngineState *s) {
 
 		// Get opcode
 		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		if (s->scriptDecodeCache) {
+			const DecodedInstruction &instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+			extOpcode = instruction.extOpcode;
+			opparams[0] = instruction.params[0];
+			opparams[1] = instruction.params[1];
+			opparams[2] = instruction.params[2];
+			opparams[3] = instruction.params[3];
+			s->xs->addr.pc.incOffset(instruction.length);
+		} else {
+			s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		}
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -919,7 +934,7 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_if_needed(s);
 			}
 
 			// Call kernel function
@@ -370,6 +370,64 @@ void script_debug(EngineState *s);
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
 		ObjVarRef *varp, reg_t *fptr);
 
+/**
+ * Cache for the results of lookupSelector(), owned by the SegManager.
+ *
+ * Entries are keyed by the object's script data and the selector, so an
+ * object, its clones and all other instances sharing the same definition
+ * use the same entry. Each entry remembers the species, superclass and
+ * class flag of the object it was filled for, and is only used when they
+ * all still match, which catches scripts changing the species or
+ * superclass of an object. Everything else an entry depends on lives in
+ * script data, so the cache is invalidated whenever scripts are loaded or
+ * freed.
+ */
+class SelectorLookupCache {
+public:
+	SelectorLookupCache();
+
+	/**
+	 * Looks up a selector in the cache. On success, the type of the
+	 * selector is returned and either varIndex or func is set, depending
+	 * on the type.
+	 */
+	bool lookup(const Object *obj, Selector selectorId, SelectorType &type, int &varIndex, reg_t &func);
+
+	/** Stores the result of a selector lookup on obj. */
+	void store(const Object *obj, Selector selectorId, SelectorType type, int varIndex, reg_t func);
+
+	/** Drops all entries, e.g. because scripts have been loaded or freed. */
+	void invalidate();
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getInvalidations() const { return _invalidations; }
+	void resetStatistics();
+
+private:
+	enum {
+		kCacheSize = 1024
+	};
+
+	struct Entry {
+		const byte *baseObj; ///< script data of the object, NULL if unused
+		reg_t species; ///< species of the object the entry was filled for
+		reg_t superClass; ///< superclass of the object the entry was filled for
+		Selector selector;
+		bool isClass;
+		SelectorType type;
+		int varIndex;
+		reg_t func;
+	};
+
+	uint hash(const byte *baseObj, Selector selectorId) const;
+
+	Entry _entries[kCacheSize];
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _invalidations;
+};
+
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
  *
@@ -37,15 +37,26 @@ namespace Sci {
 CelScaler *CelObj::_scaler = nullptr;
 
 void CelScaler::activateScaleTables(const Ratio &scaleX, const Ratio &scaleY) {
+	++_useCounter;
+
+	int oldest = 0;
 	for (int i = 0; i < ARRAYSIZE(_scaleTables); ++i) {
 		if (_scaleTables[i].scaleX == scaleX && _scaleTables[i].scaleY == scaleY) {
 			_activeIndex = i;
+			_lastUse[i] = _useCounter;
+			++_hits;
 			return;
 		}
+
+		if (_lastUse[i] < _lastUse[oldest]) {
+			oldest = i;
+		}
 	}
 
-	const int i = 1 - _activeIndex;
+	++_misses;
+	const int i = oldest;
 	_activeIndex = i;
+	_lastUse[i] = _useCounter;
 	CelScalerTable &table = _scaleTables[i];
 
 	if (table.scaleX != scaleX) {
@@ -81,12 +92,20 @@ const CelScalerTable *CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
+CelDrawStats CelObj::_frameDrawStats;
+CelDrawStats CelObj::_lastFrameDrawStats;
+CelDrawStats CelObj::_totalDrawStats;
+CelPixelCache *CelObj::_pixelCache = nullptr;
 
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
+	_frameDrawStats.reset();
+	_lastFrameDrawStats.reset();
+	_totalDrawStats.reset();
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
+	_pixelCache = new CelPixelCache(4 * 1024 * 1024);
 	_cache = new CelCache;
 	_cache->resize(100);
 }
@@ -94,6 +113,8 @@ void CelObj::init() {
 void CelObj::deinit() {
 	delete _scaler;
 	_scaler = nullptr;
+	delete _pixelCache;
+	_pixelCache = nullptr;
 	if (_cache != nullptr) {
 		for (CelCache::iterator it = _cache->begin(); it != _cache->end(); ++it) {
 			delete it->celObj;
@@ -103,6 +124,13 @@ void CelObj::deinit() {
 	_cache = nullptr;
 }
 
+void CelObj::finishFrameDrawStats() {
+	_frameDrawStats.frames = 1;
+	_totalDrawStats.add(_frameDrawStats);
+	_lastFrameDrawStats = _frameDrawStats;
+	_frameDrawStats.reset();
+}
+
 #pragma mark -
 #pragma mark CelObj - Scalers
 
@@ -151,6 +179,26 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	/**
+	 * Reads the next `width` pixels. Unflipped rows are
+	 * returned in place, flipped ones are copied into
+	 * `buffer`.
+	 */
+	inline const byte *readSpan(byte *buffer, const int16 width) {
+		if (FLIP) {
+			assert(_row - width >= _rowEdge);
+			for (int16 i = 0; i < width; ++i) {
+				buffer[i] = *_row--;
+			}
+			return buffer;
+		} else {
+			assert(_row + width <= _rowEdge);
+			const byte *span = _row;
+			_row += width;
+			return span;
+		}
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -249,6 +297,19 @@ struct SCALER_Scale {
 		assert(_x >= _minX && _x <= _maxX);
 		return _row[_valuesX[_x++]];
 	}
+
+	/**
+	 * Reads the next `width` scaled pixels into `buffer`.
+	 */
+	inline const byte *readSpan(byte *buffer, const int16 width) {
+		assert(_x >= _minX && _x + width - 1 <= _maxX);
+		const int16 *valuesX = _valuesX + _x;
+		for (int16 i = 0; i < width; ++i) {
+			buffer[i] = _row[valuesX[i]];
+		}
+		_x += width;
+		return buffer;
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -286,24 +347,35 @@ public:
 struct READER_Compressed {
 private:
 	const byte *const _resource;
+	const byte *_pixels;
 	byte _buffer[kCelScalerTableSize];
 	uint32 _controlOffset;
 	uint32 _dataOffset;
 	uint32 _uncompressedDataOffset;
 	int16 _y;
+	const int16 _sourceWidth;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
 
 public:
-	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
+	READER_Compressed(const CelObj &celObj, const int16 maxWidth, const bool useCache = true) :
 	_resource(celObj.getResPointer()),
+	_pixels(nullptr),
 	_y(-1),
+	_sourceWidth(celObj._width),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
 		assert(maxWidth <= celObj._width);
 
+		if (useCache && CelObj::_pixelCache != nullptr) {
+			_pixels = CelObj::_pixelCache->getPixels(celObj);
+			if (_pixels != nullptr) {
+				return;
+			}
+		}
+
 		const byte *const celHeader = _resource + celObj._celHeaderOffset;
 		_dataOffset = READ_SCI11ENDIAN_UINT32(celHeader + 24);
 		_uncompressedDataOffset = READ_SCI11ENDIAN_UINT32(celHeader + 28);
@@ -312,6 +384,10 @@ public:
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_pixels != nullptr) {
+			return _pixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const byte *row = _resource + _dataOffset + READ_SCI11ENDIAN_UINT32(_resource + _controlOffset + y * 4);
@@ -351,6 +427,117 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark CelPixelCache
+
+CelPixelCache::CelPixelCache(const uint32 maxMemory) :
+	_memory(0),
+	_maxMemory(maxMemory),
+	_unloadCount(0),
+	_hits(0),
+	_misses(0),
+	_evictions(0),
+	_purges(0) {}
+
+CelPixelCache::~CelPixelCache() {
+	clear();
+}
+
+void CelPixelCache::clear() {
+	for (EntryList::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		delete[] it->pixels;
+	}
+	_entries.clear();
+	_map.clear();
+	_memory = 0;
+}
+
+void CelPixelCache::remove(EntryList::iterator it) {
+	_memory -= it->size;
+	_map.erase(it->key);
+	delete[] it->pixels;
+	_entries.erase(it);
+}
+
+void CelPixelCache::purgeUnloaded() {
+	ResourceManager *resMan = g_sci->getResMan();
+	if (resMan->getUnloadCount() == _unloadCount) {
+		return;
+	}
+	_unloadCount = resMan->getUnloadCount();
+
+	EntryList::iterator it = _entries.begin();
+	while (it != _entries.end()) {
+		const Resource *resource = resMan->testResource(it->key.resourceId);
+		if (resource == nullptr || !resource->isLoaded()) {
+			EntryList::iterator goner = it++;
+			remove(goner);
+			++_purges;
+		} else {
+			++it;
+		}
+	}
+}
+
+void CelPixelCache::expand(const CelObj &celObj, byte *pixels) const {
+	READER_Compressed reader(celObj, celObj._width, false);
+	for (int16 y = 0; y < celObj._height; ++y) {
+		memcpy(pixels + y * celObj._width, reader.getRow(y), celObj._width);
+	}
+}
+
+const byte *CelPixelCache::getPixels(const CelObj &celObj) {
+	Key key;
+	if (celObj._info.type == kCelTypeView) {
+		key.resourceId = ResourceId(kResourceTypeView, celObj._info.resourceId);
+	} else if (celObj._info.type == kCelTypePic) {
+		key.resourceId = ResourceId(kResourceTypePic, celObj._info.resourceId);
+	} else {
+		return nullptr;
+	}
+	key.celHeaderOffset = celObj._celHeaderOffset;
+
+	purgeUnloaded();
+
+	EntryMap::iterator found = _map.find(key);
+	if (found != _map.end()) {
+		++_hits;
+		EntryList::iterator it = found->_value;
+		if (it != _entries.begin()) {
+			_entries.push_front(*it);
+			_entries.erase(it);
+			found->_value = _entries.begin();
+		}
+		return _entries.begin()->pixels;
+	}
+
+	++_misses;
+
+	// Very large cels would push everything else out of
+	// the cache, so those are still decompressed row by row
+	const uint32 size = celObj._width * celObj._height;
+	if (size == 0 || size > _maxMemory / 4) {
+		return nullptr;
+	}
+
+	while (_memory + size > _maxMemory) {
+		assert(!_entries.empty());
+		remove(--_entries.end());
+		++_evictions;
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.pixels = new byte[size];
+	entry.size = size;
+	expand(celObj, entry.pixels);
+
+	_entries.push_front(entry);
+	_map.setVal(key, _entries.begin());
+	_memory += size;
+	return entry.pixels;
+}
+
 #pragma mark -
 #pragma mark CelObj - Remappers
 
@@ -364,6 +551,30 @@ struct MAPPER_NoMD {
 			*target = pixel;
 		}
 	}
+
+	inline void drawSpan(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		// Four pixels at a time: build a mask with all bits set
+		// in the bytes which are not the skip color, so that
+		// opaque runs are copied and partially transparent
+		// groups are merged with the target in one go
+		const uint32 skipPattern = (uint32)skipColor * 0x01010101;
+		int16 x = 0;
+		for (; x + 4 <= width; x += 4) {
+			const uint32 pixels = READ_UINT32(source + x);
+			const uint32 diff = pixels ^ skipPattern;
+			const uint32 opaque = ((((diff & 0x7F7F7F7F) + 0x7F7F7F7F) | diff) & 0x80808080) >> 7;
+			if (opaque == 0x01010101) {
+				WRITE_UINT32(target + x, pixels);
+			} else if (opaque) {
+				const uint32 mask = opaque * 0xFF;
+				WRITE_UINT32(target + x, (pixels & mask) | (READ_UINT32(target + x) & ~mask));
+			}
+		}
+
+		for (; x < width; ++x) {
+			draw(target + x, source[x], skipColor);
+		}
+	}
 };
 
 /**
@@ -374,6 +585,10 @@ struct MAPPER_NoMDNoSkip {
 	inline void draw(byte *target, const byte pixel, const uint8) const {
 		*target = pixel;
 	}
+
+	inline void drawSpan(byte *target, const byte *source, const int16 width, const uint8) const {
+		memcpy(target, source, width);
+	}
 };
 
 /**
@@ -392,6 +607,21 @@ struct MAPPER_Map {
 			}
 		}
 	}
+
+	inline void drawSpan(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		const GfxRemap32 *remap = g_sci->_gfxRemap32;
+		const uint8 startColor = remap->getStartColor();
+		for (int16 x = 0; x < width; ++x) {
+			const byte pixel = source[x];
+			if (pixel != skipColor) {
+				if (pixel < startColor) {
+					target[x] = pixel;
+				} else if (remap->remapEnabled(pixel)) {
+					target[x] = remap->remapColor(pixel, target[x]);
+				}
+			}
+		}
+	}
 };
 
 /**
@@ -406,6 +636,16 @@ struct MAPPER_NoMap {
 			*target = pixel;
 		}
 	}
+
+	inline void drawSpan(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		const uint8 startColor = g_sci->_gfxRemap32->getStartColor();
+		for (int16 x = 0; x < width; ++x) {
+			const byte pixel = source[x];
+			if (pixel != skipColor && pixel < startColor) {
+				target[x] = pixel;
+			}
+		}
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -414,6 +654,18 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Ratio &scaleY = screenItem._ratioY;
 	_drawBlackLines = screenItem._drawBlackLines;
 
+	++_frameDrawStats.cels;
+	_frameDrawStats.pixels += targetRect.width() * targetRect.height();
+	if (!scaleX.isOne() || !scaleY.isOne()) {
+		++_frameDrawStats.scaledCels;
+	}
+	if (_compressionType != kCelCompressionNone) {
+		++_frameDrawStats.compressedCels;
+	}
+	if (_remap && g_sci->_gfxRemap32->getRemapCount()) {
+		++_frameDrawStats.remappedCels;
+	}
+
 	if (_remap) {
 		// NOTE: In the original code this check was `g_Remap_numActiveRemaps && _remap`,
 		// but since we are already in a `_remap` branch, there is no reason to check it
@@ -647,6 +899,13 @@ struct RENDERER {
 		const int16 skipStride = target.screenWidth - targetRect.width();
 		const int16 targetWidth = targetRect.width();
 		const int16 targetHeight = targetRect.height();
+		assert(targetWidth <= kCelScalerTableSize);
+
+		// Rows are read from the scaler and drawn by the mapper as
+		// whole spans, which lets both work on several pixels at
+		// a time
+		byte rowBuffer[kCelScalerTableSize];
+
 		for (int16 y = 0; y < targetHeight; ++y) {
 			if (DRAW_BLACK_LINES && (y % 2) == 0) {
 				memset(targetPixel, 0, targetWidth);
@@ -655,12 +914,9 @@ struct RENDERER {
 			}
 
 			_scaler.setTarget(targetRect.left, targetRect.top + y);
+			_mapper.drawSpan(targetPixel, _scaler.readSpan(rowBuffer, targetWidth), targetWidth, _skipColor);
 
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor);
-			}
-
-			targetPixel += skipStride;
+			targetPixel += targetWidth + skipStride;
 		}
 	}
 };
@@ -23,6 +23,8 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -187,16 +189,41 @@ struct CelScalerTable {
 };
 
 class CelScaler {
+	enum {
+		/**
+		 * The number of cached scale tables.
+		 */
+		kNumScaleTables = 8
+	};
+
 	/**
 	 * Cached scale tables.
 	 */
-	CelScalerTable _scaleTables[2];
+	CelScalerTable _scaleTables[kNumScaleTables];
+
+	/**
+	 * The time each scale table was last used, used to
+	 * find the least recently used table for replacement.
+	 */
+	uint32 _lastUse[kNumScaleTables];
+
+	/**
+	 * A monotonically increasing use counter.
+	 */
+	uint32 _useCounter;
 
 	/**
 	 * The index of the most recently used scale table.
 	 */
 	int _activeIndex;
 
+	/**
+	 * The number of lookups which found or had to build a
+	 * table.
+	 */
+	uint32 _hits;
+	uint32 _misses;
+
 	/**
 	 * Activates a scale table for the given X and Y ratios.
 	 * If there is no table that matches the given ratios,
@@ -216,7 +243,10 @@ class CelScaler {
 public:
 	CelScaler() :
 	_scaleTables(),
-	_activeIndex(0) {
+	_useCounter(0),
+	_activeIndex(0),
+	_hits(0),
+	_misses(0) {
 		CelScalerTable &table = _scaleTables[0];
 		table.scaleX = Ratio();
 		table.scaleY = Ratio();
@@ -227,12 +257,178 @@ public:
 		for (int i = 1; i < ARRAYSIZE(_scaleTables); ++i) {
 			_scaleTables[i] = _scaleTables[0];
 		}
+		for (int i = 0; i < ARRAYSIZE(_lastUse); ++i) {
+			_lastUse[i] = 0;
+		}
 	}
 
 	/**
 	 * Retrieves scaler tables for the given X and Y ratios.
 	 */
 	const CelScalerTable *getScalerTable(const Ratio &scaleX, const Ratio &scaleY);
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	void resetStatistics() { _hits = _misses = 0; }
+};
+
+#pragma mark -
+#pragma mark CelPixelCache
+
+/**
+ * A memory-budgeted cache of the decompressed pixels of
+ * RLE-compressed view and pic cels, so that a cel which is
+ * drawn on many frames is only decompressed once.
+ *
+ * The expanded bitmap is independent of the scale and
+ * mirroring a cel is drawn with, since those are applied
+ * when reading from the bitmap, so cels are keyed by their
+ * resource and cel header only. Entries for resources which
+ * have been freed by the resource manager are dropped the
+ * next time the cache is used.
+ */
+class CelPixelCache {
+public:
+	CelPixelCache(const uint32 maxMemory);
+	~CelPixelCache();
+
+	/**
+	 * Returns the decompressed pixels of the given cel,
+	 * decompressing them first if they are not cached yet.
+	 * Returns nullptr if the cel cannot be cached.
+	 */
+	const byte *getPixels(const CelObj &celObj);
+
+	/**
+	 * Removes all entries from the cache.
+	 */
+	void clear();
+
+	uint32 getMemory() const { return _memory; }
+	uint32 getMaxMemory() const { return _maxMemory; }
+	uint32 getEntryCount() const { return _entries.size(); }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getEvictions() const { return _evictions; }
+	uint32 getPurges() const { return _purges; }
+	void resetStatistics() { _hits = _misses = _evictions = _purges = 0; }
+
+private:
+	struct Key {
+		ResourceId resourceId;
+		uint32 celHeaderOffset;
+
+		bool operator==(const Key &other) const {
+			return resourceId == other.resourceId && celHeaderOffset == other.celHeaderOffset;
+		}
+	};
+
+	struct KeyHash : public Common::UnaryFunction<Key, uint> {
+		uint operator()(const Key &key) const {
+			return key.resourceId.hash() ^ (key.celHeaderOffset * 31);
+		}
+	};
+
+	struct Entry {
+		Key key;
+		byte *pixels;
+		uint32 size;
+	};
+
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Key, EntryList::iterator, KeyHash> EntryMap;
+
+	/**
+	 * The cached cels, most recently used first.
+	 */
+	EntryList _entries;
+
+	/**
+	 * Index of `_entries` by key.
+	 */
+	EntryMap _map;
+
+	/**
+	 * The number of bytes of pixel data in the cache, and
+	 * the maximum allowed.
+	 */
+	uint32 _memory;
+	const uint32 _maxMemory;
+
+	/**
+	 * The resource manager's unload count at the last
+	 * check for entries of freed resources.
+	 */
+	uint32 _unloadCount;
+
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
+	uint32 _purges;
+
+	/**
+	 * Decompresses all rows of the given cel into `pixels`.
+	 */
+	void expand(const CelObj &celObj, byte *pixels) const;
+
+	/**
+	 * Removes the given entry from the cache.
+	 */
+	void remove(EntryList::iterator it);
+
+	/**
+	 * Removes the entries of resources which are no longer
+	 * loaded.
+	 */
+	void purgeUnloaded();
+};
+
+#pragma mark -
+#pragma mark CelDrawStats
+
+/**
+ * Counters for the cels drawn by the renderer, shown by the
+ * `cel_stats` console command.
+ */
+struct CelDrawStats {
+	/**
+	 * The number of frames the counters cover.
+	 */
+	uint32 frames;
+
+	/**
+	 * The number of cels drawn, in total and by the kind of
+	 * renderer used.
+	 */
+	uint32 cels;
+	uint32 scaledCels;
+	uint32 compressedCels;
+	uint32 remappedCels;
+
+	/**
+	 * The number of target pixels drawn.
+	 */
+	uint32 pixels;
+
+	/**
+	 * The time spent drawing screen items, in milliseconds.
+	 */
+	uint32 drawTime;
+
+	void reset() {
+		frames = cels = scaledCels = compressedCels = remappedCels = 0;
+		pixels = drawTime = 0;
+	}
+
+	void add(const CelDrawStats &other) {
+		frames += other.frames;
+		cels += other.cels;
+		scaledCels += other.scaledCels;
+		compressedCels += other.compressedCels;
+		remappedCels += other.remappedCels;
+		pixels += other.pixels;
+		drawTime += other.drawTime;
+	}
 };
 
 #pragma mark -
@@ -270,6 +466,25 @@ protected:
 public:
 	static CelScaler *_scaler;
 
+	/**
+	 * Decompressed pixels of compressed view and pic cels.
+	 */
+	static CelPixelCache *_pixelCache;
+
+	/**
+	 * Draw counters for the frame currently being rendered,
+	 * the last complete frame, and all frames since the
+	 * counters were last reset.
+	 */
+	static CelDrawStats _frameDrawStats;
+	static CelDrawStats _lastFrameDrawStats;
+	static CelDrawStats _totalDrawStats;
+
+	/**
+	 * Finishes the draw counters of the current frame.
+	 */
+	static void finishFrameDrawStats();
+
 	/**
 	 * The basic identifying information for this cel. This
 	 * information effectively acts as a composite key for
@@ -71,6 +71,8 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	_remapOccurred(false),
 	_frameNowVisible(false),
 	_overdrawThreshold(0),
+	_useShowBands(true),
+	_showBandsDirty(false),
 	_palMorphIsOn(false) {
 
 	if (g_sci->getGameId() == GID_PHANTASMAGORIA) {
@@ -82,6 +84,8 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	}
 	_currentBuffer.setPixels(calloc(1, _currentBuffer.screenWidth * _currentBuffer.screenHeight));
 	_screenRect = Common::Rect(_currentBuffer.screenWidth, _currentBuffer.screenHeight);
+	_showBands.resize((_currentBuffer.screenHeight + kShowBandHeight - 1) / kShowBandHeight);
+	clearShowBands();
 	initGraphics(_currentBuffer.screenWidth, _currentBuffer.screenHeight, _isHiRes);
 
 	switch (g_sci->getGameId()) {
@@ -133,6 +137,7 @@ void GfxFrameout::clear() {
 	_planes.clear();
 	_visiblePlanes.clear();
 	_showList.clear();
+	clearShowBands();
 }
 
 // This is what Game::restore does, only needed when our ScummVM dialogs are patched in
@@ -559,6 +564,8 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 		drawScreenItemList(screenItemLists[i]);
 	}
 
+	CelObj::finishFrameDrawStats();
+
 	if (robotIsActive) {
 		robotPlayer.frameAlmostVisible();
 	}
@@ -617,6 +624,8 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 		drawScreenItemList(screenItemLists[i]);
 	}
 
+	CelObj::finishFrameDrawStats();
+
 	Palette nextPalette(_palette->getNextPalette());
 
 	if (prevRoom < 1000) {
@@ -677,6 +686,8 @@ void GfxFrameout::palMorphFrameOut(const int8 *styleRanges, PlaneShowStyle *show
 		drawScreenItemList(screenItemLists[i]);
 	}
 
+	CelObj::finishFrameDrawStats();
+
 	_palette->submit(nextPalette);
 	_palette->updateFFrame();
 	_palette->updateHardware(false);
@@ -1064,22 +1075,25 @@ void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
 
 	const RectList::size_type eraseListSize = eraseList.size();
 	for (RectList::size_type i = 0; i < eraseListSize; ++i) {
-		mergeToShowList(*eraseList[i], _showList, _overdrawThreshold);
+		addToShowList(*eraseList[i]);
 		_currentBuffer.fillRect(*eraseList[i], plane._back);
 	}
 }
 
 void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
+	const uint32 startTime = g_system->getMillis();
 	const DrawList::size_type drawListSize = screenItemList.size();
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
-		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+		addToShowList(drawItem.rect);
 		const ScreenItem &screenItem = *drawItem.screenItem;
 		// TODO: Remove
 //		debug("Drawing item %04x:%04x to %d %d %d %d", PRINT_REG(screenItem._object), PRINT_RECT(drawItem.rect));
 		CelObj &celObj = *screenItem._celObj;
 		celObj.draw(_currentBuffer, screenItem, drawItem.rect, screenItem._mirrorX ^ celObj._mirrorX);
 	}
+
+	CelObj::_frameDrawStats.drawTime += g_system->getMillis() - startTime;
 }
 
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
@@ -1140,7 +1154,84 @@ void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showLi
 	}
 }
 
+void GfxFrameout::addToShowList(const Common::Rect &drawRect) {
+	if (!_useShowBands) {
+		mergeToShowList(drawRect, _showList, _overdrawThreshold);
+		return;
+	}
+
+	Common::Rect rect(drawRect);
+	rect.clip(_screenRect);
+	if (rect.isEmpty()) {
+		return;
+	}
+
+	const int lastBand = (rect.bottom - 1) / kShowBandHeight;
+	for (int i = rect.top / kShowBandHeight; i <= lastBand; ++i) {
+		ShowBand &band = _showBands[i];
+		if (band.left >= band.right) {
+			band.left = rect.left;
+			band.right = rect.right;
+		} else {
+			band.left = MIN(band.left, rect.left);
+			band.right = MAX(band.right, rect.right);
+		}
+	}
+
+	_showBandsDirty = true;
+}
+
+void GfxFrameout::clearShowBands() {
+	for (uint i = 0; i < _showBands.size(); ++i) {
+		_showBands[i].left = _showBands[i].right = 0;
+	}
+	_showBandsDirty = false;
+}
+
+void GfxFrameout::flushShowBands() {
+	if (!_showBandsDirty) {
+		return;
+	}
+
+	Common::Rect rect;
+	for (uint i = 0; i < _showBands.size(); ++i) {
+		const ShowBand &band = _showBands[i];
+		if (band.left >= band.right) {
+			continue;
+		}
+
+		const int16 top = i * kShowBandHeight;
+		const int16 bottom = MIN<int16>(top + kShowBandHeight, _screenRect.bottom);
+
+		if (!rect.isEmpty() && rect.bottom == top && band.left < rect.right && band.right > rect.left) {
+			rect.left = MIN(rect.left, band.left);
+			rect.right = MAX(rect.right, band.right);
+			rect.bottom = bottom;
+		} else {
+			if (!rect.isEmpty()) {
+				_showList.add(rect);
+			}
+			rect = Common::Rect(band.left, top, band.right, bottom);
+		}
+	}
+
+	if (!rect.isEmpty()) {
+		_showList.add(rect);
+	}
+
+	clearShowBands();
+}
+
+void GfxFrameout::setUseShowBands(const bool enable) {
+	if (!enable) {
+		flushShowBands();
+	}
+	_useShowBands = enable;
+}
+
 void GfxFrameout::showBits() {
+	flushShowBands();
+
 	if (!_showList.size()) {
 		g_system->updateScreen();
 		return;
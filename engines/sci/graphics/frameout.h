@@ -232,6 +232,54 @@ private:
 	 */
 	int _overdrawThreshold;
 
+	enum {
+		/**
+		 * The number of screen rows in one show band.
+		 */
+		kShowBandHeight = 8
+	};
+
+	/**
+	 * The horizontal extent of the area of one band of
+	 * `kShowBandHeight` screen rows that has been drawn to
+	 * since the last call to showBits. The band is clean
+	 * when `left` >= `right`.
+	 */
+	struct ShowBand {
+		int16 left;
+		int16 right;
+	};
+
+	/**
+	 * When true, the rects drawn by frameOut are tracked in
+	 * `_showBands` instead of being merged into the show
+	 * list one by one, which takes time quadratic in the
+	 * number of rects on busy frames.
+	 */
+	bool _useShowBands;
+
+	/**
+	 * The damaged area of each band of the screen.
+	 */
+	Common::Array<ShowBand> _showBands;
+
+	/**
+	 * Whether any of the show bands are damaged.
+	 */
+	bool _showBandsDirty;
+
+	/**
+	 * Marks all show bands as clean.
+	 */
+	void clearShowBands();
+
+	/**
+	 * Adds the damaged bands to the show list, joining
+	 * vertically adjacent bands with overlapping extents
+	 * into one rect, and marks all bands as clean.
+	 */
+	void flushShowBands();
+
 	/**
 	 * A list of planes that are currently drawn to the
 	 * hardware display surface. Used to calculate
@@ -276,6 +324,13 @@ private:
 	 */
 	void mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold);
 
+	/**
+	 * Adds a rect drawn by frameOut to the regions to write
+	 * out to the hardware, either to the show bands or to
+	 * the show list.
+	 */
+	void addToShowList(const Common::Rect &drawRect);
+
 	/**
 	 * Writes the internal frame buffer out to hardware and
 	 * clears the show list.
@@ -307,6 +362,13 @@ private:
 	}
 
 public:
+	/**
+	 * Enables or disables tracking drawn areas in bands of
+	 * screen rows instead of merging the show list rects.
+	 */
+	void setUseShowBands(const bool enable);
+	bool getUseShowBands() const { return _useShowBands; }
+
 	/**
 	 * Whether or not the data in the current buffer is what
 	 * is visible to the user. During rendering updates,
@@ -22,9 +22,11 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
@@ -198,6 +200,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : _resMan(resMan), _i
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_prefetched = false;
 	_source = NULL;
 	_header = NULL;
 	_headerSize = 0;
@@ -214,6 +217,7 @@ void Resource::unalloc() {
 	delete[] data;
 	data = NULL;
 	_status = kResStatusNoMalloc;
+	_prefetched = false;
 }
 
 void Resource::writeToStream(Common::WriteStream *stream) const {
@@ -888,7 +892,10 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_unloadCount = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
+	_cacheStats.reset();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -949,6 +956,11 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// The cache size can be overridden from the configuration, in KiB
+	if (ConfMan.hasKey("resource_cache_size")) {
+		_maxMemoryLRU = MAX(ConfMan.getInt("resource_cache_size"), 0) * 1024;
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1038,12 +1050,80 @@ void ResourceManager::freeOldResources() {
 		Resource *goner = *_LRU.reverse_begin();
 		removeFromLRU(goner);
 		goner->unalloc();
+		++_unloadCount;
+		++_cacheStats.evictions;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
 	}
 }
 
+void ResourceManager::queuePrefetch(ResourceId id) {
+	// Keep the queue short, so that it only ever holds resources which are
+	// likely to be needed soon
+	if (_prefetchQueue.size() >= 64)
+		return;
+
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	for (Common::List<ResourceId>::const_iterator it = _prefetchQueue.begin(); it != _prefetchQueue.end(); ++it) {
+		if (*it == id)
+			return;
+	}
+
+	_prefetchQueue.push_back(id);
+}
+
+void ResourceManager::queueRoomPrefetch(uint16 roomNumber) {
+	// By convention, the scripts and most of the graphics and sounds of a
+	// room share the room number
+	static const ResourceType roomTypes[] = {
+		kResourceTypeScript, kResourceTypeHeap, kResourceTypePic,
+		kResourceTypeView, kResourceTypeMessage, kResourceTypeSound
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(roomTypes); ++i)
+		queuePrefetch(ResourceId(roomTypes[i], roomNumber));
+}
+
+bool ResourceManager::processPrefetchQueue(uint32 deadline) {
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && g_system->getMillis() < deadline) {
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		if (_memoryLRU + (int)res->size > _maxMemoryLRU) {
+			++_cacheStats.prefetchSkipped;
+			continue;
+		}
+
+		loadResource(res);
+		loaded = true;
+
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		// The size of some resources is only known once they are loaded
+		if (_memoryLRU + (int)res->size > _maxMemoryLRU) {
+			res->unalloc();
+			++_cacheStats.prefetchSkipped;
+			continue;
+		}
+
+		res->_prefetched = true;
+		addToLRU(res);
+		++_cacheStats.prefetched;
+	}
+
+	return loaded;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1063,15 +1143,24 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		++_cacheStats.misses;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		// The resource is removed from its current position
-		// in the LRU list because it has been requested
-		// again. Below, it will either be locked, or it
-		// will be added back to the LRU list at the 'most
-		// recent' position.
-		removeFromLRU(retval);
+	} else {
+		++_cacheStats.hits;
+		if (retval->_prefetched) {
+			++_cacheStats.prefetchHits;
+			retval->_prefetched = false;
+		}
+
+		if (retval->_status == kResStatusEnqueued)
+			// The resource is removed from its current position
+			// in the LRU list because it has been requested
+			// again. Below, it will either be locked, or it
+			// will be added back to the LRU list at the 'most
+			// recent' position.
+			removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
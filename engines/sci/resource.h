@@ -137,6 +137,26 @@ enum ResVersion {
 class ResourceManager;
 class ResourceSource;
 
+/**
+ * Counters for the resource cache, shown by the `resource_stats` console
+ * command.
+ */
+struct ResourceCacheStats {
+	uint32 hits;            ///< Requests for resources which were already loaded
+	uint32 misses;          ///< Requests which had to load the resource
+	uint32 evictions;       ///< Resources freed to stay within the memory limit
+	uint32 prefetched;      ///< Resources loaded ahead of time
+	uint32 prefetchHits;    ///< Requests for resources which had been prefetched
+	uint32 prefetchSkipped; ///< Queued resources which did not fit in the cache
+
+	ResourceCacheStats() { reset(); }
+
+	void reset() {
+		hits = misses = evictions = 0;
+		prefetched = prefetchHits = prefetchSkipped = 0;
+	}
+};
+
 class ResourceId {
 	static inline ResourceType fixupType(ResourceType type) {
 		if (type >= kResourceTypeInvalid)
@@ -256,6 +276,7 @@ public:
 	inline ResourceType getType() const { return _id.getType(); }
 	inline uint16 getNumber() const { return _id.getNumber(); }
 	bool isLocked() const { return _status == kResStatusLocked; }
+	bool isLoaded() const { return _status != kResStatusNoMalloc; }
 	/**
 	 * Write the resource to the specified stream.
 	 * This method is used only by the "dump" debugger command.
@@ -278,6 +299,7 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	bool _prefetched; /**< Loaded by the prefetcher and not requested since */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -370,6 +392,53 @@ public:
 	 */
 	Common::List<ResourceId> listResources(ResourceType type, int mapNumber = -1);
 
+	/**
+	 * Returns the number of times resources have been freed to stay within
+	 * the memory limit, so that caches of data derived from resources can
+	 * tell when to check for resources which are gone.
+	 */
+	uint32 getUnloadCount() const { return _unloadCount; }
+
+	/**
+	 * Queues a resource to be loaded ahead of time, while the engine is
+	 * otherwise idle. Resources are only prefetched while they fit in the
+	 * memory limit, so prefetching never pushes out resources in use.
+	 * @param id	Id of the resource to load
+	 */
+	void queuePrefetch(ResourceId id);
+
+	/**
+	 * Queues the resources a room is likely to use as soon as it is
+	 * entered: its script, and the pic, views, messages and sounds with
+	 * the same number.
+	 * @param roomNumber	The number of the room
+	 */
+	void queueRoomPrefetch(uint16 roomNumber);
+
+	/**
+	 * Loads queued resources until the queue is empty or the given time
+	 * has been reached.
+	 * @param deadline	The value of OSystem::getMillis to stop at
+	 * @return			true if any resource was loaded
+	 */
+	bool processPrefetchQueue(uint32 deadline);
+
+	/**
+	 * Returns the maximum size of the resource cache, in bytes.
+	 */
+	int getMaxMemory() const { return _maxMemoryLRU; }
+
+	/**
+	 * Returns the number of bytes used by cached and locked resources.
+	 */
+	int getMemoryUsed() const { return _memoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+
+	uint getPrefetchQueueSize() const { return _prefetchQueue.size(); }
+
+	const ResourceCacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats() { _cacheStats.reset(); }
+
 	void setAudioLanguage(int language);
 	int getAudioLanguage() const;
 	void changeAudioDirectory(const Common::String &path);
@@ -458,6 +527,9 @@ protected:
 	Common::List<ResourceSource *> _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
+	uint32 _unloadCount;	///< Number of resources freed by freeOldResources
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load while idle
+	ResourceCacheStats _cacheStats;
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
@@ -1006,7 +1006,10 @@ void SciEngine::sleep(uint32 msecs) {
 		_eventMan->getSciEvent(SCI_EVENT_PEEK);
 		time = g_system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			g_system->delayMillis(10);
+			// Use the idle time to load resources which are likely to be
+			// needed soon
+			if (!_resMan->processPrefetchQueue(time + 10))
+				g_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				g_system->delayMillis(wakeUpTime - time);
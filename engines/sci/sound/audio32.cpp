@@ -325,7 +325,7 @@ int Audio32::readBuffer(Audio::st_sample_t *buffer, const int numSamples) {
 				_monitoredBufferSize = bufferSize;
 			}
 
-			memset(_monitoredBuffer, 0, _monitoredBufferSize);
+			memset(_monitoredBuffer, 0, bufferSize);
 
 			_numMonitoredSamples = writeAudioInternal(channel.stream, channel.converter, _monitoredBuffer, numSamples, leftVolume, rightVolume, channel.loop);
 
@@ -503,6 +503,61 @@ void Audio32::unlockResources() {
 	_resourcesToUnlock.clear();
 }
 
+Audio::SeekableAudioStream *Audio32::decodeStream(Audio::SeekableAudioStream *stream) const {
+	const int numChannels = stream->isStereo() ? 2 : 1;
+
+	// The length of a SOL stream is rounded to ticks, so it is
+	// only used to size the buffer and the actual number of
+	// samples is whatever the decoder produces
+	const uint32 kChunkSize = 4096;
+	uint32 capacity = stream->getLength().totalNumberOfFrames() * numChannels + kChunkSize;
+	if (capacity * sizeof(int16) > kMaxDecodedSize) {
+		return stream;
+	}
+
+	int16 *data = (int16 *)malloc(capacity * sizeof(int16));
+	if (data == nullptr) {
+		return stream;
+	}
+
+	uint32 numSamples = 0;
+	while (!stream->endOfData()) {
+		if (capacity - numSamples < kChunkSize) {
+			capacity += kChunkSize;
+			int16 *newData = nullptr;
+			if (capacity * sizeof(int16) <= kMaxDecodedSize) {
+				newData = (int16 *)realloc(data, capacity * sizeof(int16));
+			}
+
+			if (newData == nullptr) {
+				free(data);
+				stream->rewind();
+				return stream;
+			}
+			data = newData;
+		}
+
+		// The chunk size is even, as 8-bit SOL streams require
+		const int samplesRead = stream->readBuffer(data + numSamples, kChunkSize);
+		if (samplesRead <= 0) {
+			break;
+		}
+		numSamples += samplesRead;
+	}
+
+	byte flags = Audio::FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+	if (numChannels == 2) {
+		flags |= Audio::FLAG_STEREO;
+	}
+
+	Audio::SeekableAudioStream *decodedStream = Audio::makeRawStream((const byte *)data, numSamples * sizeof(int16), stream->getRate(), flags, DisposeAfterUse::YES);
+	delete stream;
+	return decodedStream;
+}
+
 #pragma mark -
 #pragma mark Script compatibility
 
@@ -639,29 +694,33 @@ bool Audio32::stopRobotAudio() {
 #pragma mark Playback
 
 uint16 Audio32::play(int16 channelIndex, const ResourceId resourceId, const bool autoPlay, const bool loop, const int16 volume, const reg_t soundNode, const bool monitor) {
-	Common::StackLock lock(_mutex);
+	{
+		Common::StackLock lock(_mutex);
 
-	freeUnusedChannels();
+		freeUnusedChannels();
 
-	if (channelIndex != kNoExistingChannel) {
-		AudioChannel &channel = getChannel(channelIndex);
-		Audio::SeekableAudioStream *stream = dynamic_cast<Audio::SeekableAudioStream *>(channel.stream);
-		if (stream == nullptr) {
-			error("[Audio32::play]: Unable to cast stream for resource %s", resourceId.toString().c_str());
-		}
+		if (channelIndex != kNoExistingChannel) {
+			AudioChannel &channel = getChannel(channelIndex);
+			Audio::SeekableAudioStream *stream = dynamic_cast<Audio::SeekableAudioStream *>(channel.stream);
+			if (stream == nullptr) {
+				error("[Audio32::play]: Unable to cast stream for resource %s", resourceId.toString().c_str());
+			}
 
-		if (channel.pausedAtTick) {
-			resume(channelIndex);
-			return MIN(65534, 1 + stream->getLength().msecs() * 60 / 1000);
-		}
+			if (channel.pausedAtTick) {
+				resume(channelIndex);
+				return MIN<uint32>(65534, channel.duration);
+			}
 
-		warning("Tried to resume channel %s that was not paused", channel.id.toString().c_str());
-		return MIN(65534, 1 + stream->getLength().msecs() * 60 / 1000);
-	}
+			warning("Tried to resume channel %s that was not paused", channel.id.toString().c_str());
+			return MIN<uint32>(65534, channel.duration);
+		}
 
-	if (_numActiveChannels == _channels.size()) {
-		warning("Audio mixer is full when trying to play %s", resourceId.toString().c_str());
-		return 0;
+		// Channels are only ever added from the main thread, so
+		// the mixer cannot fill up again once the lock is released
+		if (_numActiveChannels == _channels.size()) {
+			warning("Audio mixer is full when trying to play %s", resourceId.toString().c_str());
+			return 0;
+		}
 	}
 
 	// NOTE: SCI engine itself normally searches in this order:
@@ -706,30 +765,15 @@ uint16 Audio32::play(int16 channelIndex, const ResourceId resourceId, const bool
 		return 0;
 	}
 
-	channelIndex = _numActiveChannels++;
-
-	AudioChannel &channel = getChannel(channelIndex);
-	channel.id = resourceId;
-	channel.resource = resource;
-	channel.loop = loop;
-	channel.robot = false;
-	channel.fadeStartTick = 0;
-	channel.soundNode = soundNode;
-	channel.volume = volume < 0 || volume > kMaxVolume ? (int)kMaxVolume : volume;
-	// TODO: SCI3 introduces stereo audio
-	channel.pan = -1;
-
-	if (monitor) {
-		_monitoredChannelIndex = channelIndex;
-	}
-
 	Common::MemoryReadStream headerStream(resource->_header, resource->_headerSize, DisposeAfterUse::NO);
-	Common::SeekableReadStream *dataStream = channel.resourceStream = resource->makeStream();
+	Common::SeekableReadStream *dataStream = resource->makeStream();
+	Audio::SeekableAudioStream *stream;
 
-	if (detectSolAudio(headerStream)) {
-		channel.stream = makeSOLStream(&headerStream, dataStream, DisposeAfterUse::NO);
+	const bool isCompressed = detectSolAudio(headerStream);
+	if (isCompressed) {
+		stream = makeSOLStream(&headerStream, dataStream, DisposeAfterUse::NO);
 	} else if (detectWaveAudio(*dataStream)) {
-		channel.stream = Audio::makeWAVStream(dataStream, DisposeAfterUse::NO);
+		stream = Audio::makeWAVStream(dataStream, DisposeAfterUse::NO);
 	} else {
 		byte flags = Audio::FLAG_LITTLE_ENDIAN;
 		if (_globalBitDepth == 16) {
@@ -742,7 +786,44 @@ uint16 Audio32::play(int16 channelIndex, const ResourceId resourceId, const bool
 			flags |= Audio::FLAG_STEREO;
 		}
 
-		channel.stream = Audio::makeRawStream(dataStream, _globalSampleRate, flags, DisposeAfterUse::NO);
+		stream = Audio::makeRawStream(dataStream, _globalSampleRate, flags, DisposeAfterUse::NO);
+	}
+
+	if (stream == nullptr) {
+		error("[Audio32::play]: Unable to create stream for resource %s", resourceId.toString().c_str());
+	}
+
+	// The duration reported to scripts comes from the original
+	// stream, since decompressed streams measure their length
+	// slightly differently
+	const uint32 duration = /* round up */ 1 + (stream->getLength().msecs() * 60 / 1000);
+
+	if (isCompressed) {
+		stream = decodeStream(stream);
+	}
+
+	// The stream is created (and, for compressed audio, decoded)
+	// without holding the mixer lock, so the audio thread is not
+	// held up while a new sample is prepared
+	Common::StackLock lock(_mutex);
+
+	channelIndex = _numActiveChannels++;
+
+	AudioChannel &channel = getChannel(channelIndex);
+	channel.id = resourceId;
+	channel.resource = resource;
+	channel.resourceStream = dataStream;
+	channel.stream = stream;
+	channel.loop = loop;
+	channel.robot = false;
+	channel.fadeStartTick = 0;
+	channel.soundNode = soundNode;
+	channel.volume = volume < 0 || volume > kMaxVolume ? (int)kMaxVolume : volume;
+	// TODO: SCI3 introduces stereo audio
+	channel.pan = -1;
+
+	if (monitor) {
+		_monitoredChannelIndex = channelIndex;
 	}
 
 	channel.converter = Audio::makeRateConverter(channel.stream->getRate(), getRate(), channel.stream->isStereo(), false);
@@ -751,16 +832,12 @@ uint16 Audio32::play(int16 channelIndex, const ResourceId resourceId, const bool
 	// stream, plus writes information about the sample to the channel to
 	// convert to the correct hardware output format, and allocates the
 	// monitoring buffer to match the bitrate/samplerate/channels of the
-	// original stream. We do not need to do any of these things since we
+	// original stream. We do not need to do most of these things since we
 	// use audio streams, and allocate and fill the monitoring buffer
-	// when reading audio data from the stream.
-
-	Audio::SeekableAudioStream *stream = dynamic_cast<Audio::SeekableAudioStream *>(channel.stream);
-	if (stream == nullptr) {
-		error("[Audio32::play]: Unable to cast stream for resource %s", resourceId.toString().c_str());
-	}
+	// when reading audio data from the stream; the equivalent of the
+	// decompression buffer is set up by `decodeStream` above.
 
-	channel.duration = /* round up */ 1 + (stream->getLength().msecs() * 60 / 1000);
+	channel.duration = duration;
 
 	const uint32 now = g_sci->getTickCount();
 	channel.pausedAtTick = autoPlay ? 0 : now;
@@ -170,7 +170,13 @@ private:
 		/**
 		 * The maximum channel volume.
 		 */
-		kMaxVolume = 127
+		kMaxVolume = 127,
+
+		/**
+		 * The largest amount of audio data, in bytes, that
+		 * is decompressed in advance for a single channel.
+		 */
+		kMaxDecodedSize = 2 * 1024 * 1024
 	};
 
 #pragma mark -
@@ -282,6 +288,16 @@ private:
 	 */
 	void unlockResources();
 
+	/**
+	 * Decompresses the whole of the given stream into
+	 * memory, so that the audio thread only needs to copy
+	 * samples when mixing the channel. Returns a new
+	 * stream and deletes the old one on success, or the
+	 * original stream if it decodes to more than
+	 * `kMaxDecodedSize` bytes.
+	 */
+	Audio::SeekableAudioStream *decodeStream(Audio::SeekableAudioStream *stream) const;
+
 #pragma mark -
 #pragma mark Script compatibility
 public:
@@ -451,6 +451,33 @@ public:
 	virtual void drawStep(const Common::Rect &area, const DrawStep &step, uint32 extra = 0);
 	virtual void drawStepClip(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Sets up the renderer state (colors, fill mode, stroke...) of the given
+	 * draw step without drawing anything. Used when the output of a step has
+	 * been cached, so the state seen by the following steps stays the same.
+	 *
+	 * @param step Pointer to a DrawStep struct.
+	 * @param extra Dynamic data of the step.
+	 */
+	void applyStepState(const DrawStep &step, uint32 extra = 0);
+
+	/** Number of values stored by getColorState() */
+	enum { kColorStateSize = 5 };
+
+	/**
+	 * Stores all the colors currently set in the renderer. Draw steps which
+	 * do not set some of their colors use the ones left behind by previous
+	 * steps, so these are part of the key of any cached drawing.
+	 *
+	 * @param state Array receiving the colors in the surface pixel format.
+	 */
+	virtual void getColorState(uint32 (&state)[kColorStateSize]) const = 0;
+
+	/**
+	 * Returns the surface currently being drawn on.
+	 */
+	TransparentSurface *getActiveSurface() const { return _activeSurface; }
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -515,6 +542,7 @@ public:
 	 */
 	virtual void disableShadows() { _disableShadows = true; }
 	virtual void enableShadows() { _disableShadows = false; }
+	bool shadowsDisabled() const { return _disableShadows; }
 
 	/**
 	 * Applies a whole-screen shading effect, used before opening a new dialog.
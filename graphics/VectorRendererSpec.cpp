@@ -540,6 +540,9 @@ VectorRendererSpec(PixelFormat format) :
 
 	_bitmapAlphaColor = _format.RGBToColor(255, 0, 255);
 	_clippingArea = Common::Rect(0, 0, 32767, 32767);
+
+	_fgColor = _bgColor = _bevelColor = 0;
+	_gradientStart = _gradientEnd = 0;
 }
 
 /****************************
@@ -629,16 +632,20 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
+		// The dithered color only depends on the parity of the column,
+		// so work out both of them once for the whole span.
+		PixelType colors[2];
+		for (int oy = 0; oy < 2; ++oy) {
 			if ((ox && oy) ||
 				((grad == 2 || grad == 3) && ox && !oy) ||
 				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
+				colors[oy] = _gradCache[curGrad + 1];
 			else
-				*ptr = _gradCache[curGrad];
+				colors[oy] = _gradCache[curGrad];
 		}
+
+		for (int j = x; j < x + width; j++)
+			*ptr++ = colors[j & 1];
 	}
 }
 
@@ -1055,6 +1062,63 @@ blendPixelPtr(PixelType *ptr, PixelType color, uint8 alpha) {
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+	if (first >= last)
+		return;
+
+	if (alpha == 0xff) {
+		// fully opaque span, don't blend
+		colorFill<PixelType>(first, last, color | _alphaMask);
+		return;
+	}
+
+	// The per-pixel blending in blendPixelPtr() computes d + (((s - d) * a) >> 8)
+	// for every channel, which is the same as (d * (256 - a) + s * a) >> 8.
+	// The source part of the latter only has to be computed once per span.
+	const uint invAlpha = 256 - alpha;
+
+	if (sizeof(PixelType) == 4) {
+		if ((_format.rShift | _format.gShift | _format.bShift | _format.aShift) & 7 ||
+		    _format.rLoss || _format.gLoss || _format.bLoss || (_format.aLoss != 0 && _format.aLoss != 8)) {
+			// Channels not aligned to bytes
+			while (first != last)
+				blendPixelPtr(first++, color, alpha);
+			return;
+		}
+
+		// Blend two channels at once: each intermediate result fits in 16 bits
+		const uint32 src = color | _alphaMask;
+		const uint32 srcRB = (src & 0x00FF00FF) * alpha;
+		const uint32 srcAG = ((src >> 8) & 0x00FF00FF) * alpha;
+		const uint32 mask = _redMask | _greenMask | _blueMask | _alphaMask;
+
+		while (first != last) {
+			const uint32 dst = *first;
+			const uint32 rb = ((((dst & 0x00FF00FF) * invAlpha + srcRB) >> 8) & 0x00FF00FF);
+			const uint32 ag = ((((dst >> 8) & 0x00FF00FF) * invAlpha + srcAG) & 0xFF00FF00);
+			*first++ = (PixelType)((rb | ag) & mask);
+		}
+	} else if (sizeof(PixelType) == 2) {
+		const uint srcR = (color & _redMask) * alpha;
+		const uint srcG = (color & _greenMask) * alpha;
+		const uint srcB = (color & _blueMask) * alpha;
+		const uint srcA = _alphaMask * alpha;
+
+		while (first != last) {
+			const uint dst = *first;
+			*first++ = (PixelType)(
+				(_redMask & (((dst & _redMask) * invAlpha + srcR) >> 8)) |
+				(_greenMask & (((dst & _greenMask) * invAlpha + srcG) >> 8)) |
+				(_blueMask & (((dst & _blueMask) * invAlpha + srcB) >> 8)) |
+				(_alphaMask & (((dst & _alphaMask) * invAlpha + srcA) >> 8)));
+		}
+	} else {
+		error("Unsupported BPP format: %u", (uint)sizeof(PixelType));
+	}
+}
+
 template<typename PixelType>
 inline void VectorRendererSpec<PixelType>::
 blendPixelPtrClip(PixelType *ptr, PixelType color, uint8 alpha, int x, int y) {
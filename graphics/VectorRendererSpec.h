@@ -85,6 +85,14 @@ public:
 	void setBevelColor(uint8 r, uint8 g, uint8 b) { _bevelColor = _format.RGBToColor(r, g, b); }
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2);
 
+	void getColorState(uint32 (&state)[kColorStateSize]) const {
+		state[0] = _fgColor;
+		state[1] = _bgColor;
+		state[2] = _bevelColor;
+		state[3] = _gradientStart;
+		state[4] = _gradientEnd;
+	}
+
 	void copyFrame(OSystem *sys, const Common::Rect &r);
 	void copyWholeFrame(OSystem *sys) { copyFrame(sys, Common::Rect(0, 0, _activeSurface->w, _activeSurface->h)); }
 
@@ -288,20 +296,18 @@ protected:
 	 * @param color Color of the pixel
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
-	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
-		while (first != last) blendPixelPtr(first++, color, alpha);
-	}
+	void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha);
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
-		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first != last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
-		}
+		if (realY < _clippingArea.top || realY >= _clippingArea.bottom)
+			return;
+
+		// Narrow the span down to the clipping area and blend it in one go
+		const int start = MAX<int>(realX, _clippingArea.left) - realX;
+		const int end = MIN<int>(realX + (last - first), _clippingArea.right) - realX;
+
+		if (start < end)
+			blendFill(first + start, first + end, color, alpha);
 	}
 
 	void darkenFill(PixelType *first, PixelType *last);
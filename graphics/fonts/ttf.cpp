@@ -143,7 +143,20 @@ private:
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
-	void assureCached(uint32 chr) const;
+
+	/**
+	 * Returns the cached glyph of the given character, caching it first if
+	 * late caching is allowed. Returns 0 if the font has no such glyph.
+	 */
+	const Glyph *getGlyph(uint32 chr) const;
+
+	/**
+	 * Kerning offsets already queried from FreeType. The key holds the left
+	 * glyph slot in the upper 16 bits and the right one in the lower 16 bits,
+	 * which is enough since TrueType fonts cannot have more than 65536 glyphs.
+	 */
+	typedef Common::HashMap<uint32, int> KerningCache;
+	mutable KerningCache _kerning;
 
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
@@ -405,55 +418,51 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph)
 		return 0;
 	else
-		return glyphEntry->_value.advance;
+		return glyph->advance;
 }
 
 int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
-	assureCached(left);
-	assureCached(right);
-
-	FT_UInt leftGlyph, rightGlyph;
-	GlyphCache::const_iterator glyphEntry;
-
-	glyphEntry = _glyphs.find(left);
-	if (glyphEntry != _glyphs.end()) {
-		leftGlyph = glyphEntry->_value.slot;
-	} else {
+	const Glyph *glyph = getGlyph(left);
+	if (!glyph)
 		return 0;
-	}
+	const FT_UInt leftGlyph = glyph->slot;
 
-	glyphEntry = _glyphs.find(right);
-	if (glyphEntry != _glyphs.end()) {
-		rightGlyph = glyphEntry->_value.slot;
-	} else {
+	glyph = getGlyph(right);
+	if (!glyph)
 		return 0;
-	}
+	const FT_UInt rightGlyph = glyph->slot;
 
 	if (!leftGlyph || !rightGlyph)
 		return 0;
 
+	const uint32 key = ((leftGlyph & 0xFFFF) << 16) | (rightGlyph & 0xFFFF);
+	KerningCache::const_iterator kerningEntry = _kerning.find(key);
+	if (kerningEntry != _kerning.end())
+		return kerningEntry->_value;
+
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+
+	const int offset = kerningVector.x / 64;
+	_kerning[key] = offset;
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end()) {
+	const Glyph *glyph = getGlyph(chr);
+	if (!glyph) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
+		const int xOffset = glyph->xOffset;
+		const int yOffset = glyph->yOffset;
+		const Graphics::Surface &image = glyph->image;
 		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
 	}
 }
@@ -497,12 +506,11 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
+	const Glyph *glyphPtr = getGlyph(chr);
+	if (!glyphPtr)
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = *glyphPtr;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -644,15 +652,19 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	return true;
 }
 
-void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
-		return;
-	}
+const TTFFont::Glyph *TTFFont::getGlyph(uint32 chr) const {
+	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	if (glyphEntry != _glyphs.end())
+		return &glyphEntry->_value;
+
+	if (!chr || !_allowLateCaching)
+		return 0;
 
 	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
-	}
+	if (!cacheGlyph(newGlyph, chr))
+		return 0;
+
+	return &(_glyphs[chr] = newGlyph);
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping) {
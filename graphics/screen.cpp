@@ -27,77 +27,153 @@
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+Screen::Screen(): ManagedSurface(), _dirtyTilesW(0), _dirtyTilesH(0), _dirtyTileCount(0),
+		_updateRectCount(0), _updatePixelCount(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _dirtyTilesW(0), _dirtyTilesH(0),
+		_dirtyTileCount(0), _updateRectCount(0), _updatePixelCount(0) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _dirtyTilesW(0),
+		_dirtyTilesH(0), _dirtyTileCount(0), _updateRectCount(0), _updatePixelCount(0) {
 	create(width, height, pixelFormat);
 }
 
 void Screen::update() {
-	// Merge the dirty rects
-	mergeDirtyRects();
+	// Get the areas covered by dirty tiles
+	Common::Array<Common::Rect> rects;
+	getDirtyRects(rects);
+
+	_updateRectCount = 0;
+	_updatePixelCount = 0;
 
 	// Loop through copying dirty areas to the physical screen
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
+	for (uint i = 0; i < rects.size(); ++i) {
+		Common::Rect r = rects[i];
+		r.clip(getBounds());
+		if (r.isEmpty())
+			continue;
+
 		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
 		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
 			r.width(), r.height());
+
+		++_updateRectCount;
+		_updatePixelCount += r.width() * r.height();
 	}
 
 	// Signal the physical screen to update
 	g_system->updateScreen();
-	_dirtyRects.clear();
+	clearDirtyRects();
 }
 
-
 void Screen::addDirtyRect(const Common::Rect &r) {
 	Common::Rect bounds = r;
 	bounds.clip(getBounds());
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
-	if (bounds.width() > 0 && bounds.height() > 0)
-		_dirtyRects.push_back(bounds);
+	if (bounds.width() <= 0 || bounds.height() <= 0 || bounds.left < 0 || bounds.top < 0)
+		return;
+
+	ensureDirtyTiles(bounds.right, bounds.bottom);
+
+	const int x0 = bounds.left >> kDirtyTileShift;
+	const int x1 = (bounds.right - 1) >> kDirtyTileShift;
+	const int y0 = bounds.top >> kDirtyTileShift;
+	const int y1 = (bounds.bottom - 1) >> kDirtyTileShift;
+
+	for (int y = y0; y <= y1; ++y) {
+		byte *tile = &_dirtyTiles[y * _dirtyTilesW + x0];
+		for (int x = x0; x <= x1; ++x, ++tile) {
+			if (!*tile) {
+				*tile = 1;
+				++_dirtyTileCount;
+			}
+		}
+	}
+}
+
+void Screen::clearDirtyRects() {
+	if (_dirtyTileCount) {
+		Common::fill(_dirtyTiles.begin(), _dirtyTiles.end(), 0);
+		_dirtyTileCount = 0;
+	}
 }
 
 void Screen::makeAllDirty() {
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
-void Screen::mergeDirtyRects() {
-	Common::List<Common::Rect>::iterator rOuter, rInner;
-
-	// Process the dirty rect list to find any rects to merge
-	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
-		rInner = rOuter;
-		while (++rInner != _dirtyRects.end()) {
+void Screen::ensureDirtyTiles(int right, int bottom) {
+	const int tilesW = (MAX<int>(right, this->w) + (1 << kDirtyTileShift) - 1) >> kDirtyTileShift;
+	const int tilesH = (MAX<int>(bottom, this->h) + (1 << kDirtyTileShift) - 1) >> kDirtyTileShift;
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
+	if (tilesW <= _dirtyTilesW && tilesH <= _dirtyTilesH)
+		return;
 
-				// remove the inner rect from the list
-				_dirtyRects.erase(rInner);
+	// Grow the tiles, keeping the ones already marked
+	const int newW = MAX(tilesW, _dirtyTilesW);
+	const int newH = MAX(tilesH, _dirtyTilesH);
+	Common::Array<byte> tiles;
+	tiles.resize(newW * newH);
+	Common::fill(tiles.begin(), tiles.end(), 0);
 
-				// move back to beginning of list
-				rInner = rOuter;
-			}
-		}
+	for (int y = 0; y < _dirtyTilesH; ++y) {
+		for (int x = 0; x < _dirtyTilesW; ++x)
+			tiles[y * newW + x] = _dirtyTiles[y * _dirtyTilesW + x];
 	}
+
+	_dirtyTiles = tiles;
+	_dirtyTilesW = newW;
+	_dirtyTilesH = newH;
 }
 
-bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
-	destRect = src1;
-	destRect.extend(src2);
+void Screen::getDirtyRects(Common::Array<Common::Rect> &rects) const {
+	if (!_dirtyTileCount)
+		return;
+
+	// Indexes of the rects reaching the previous and the current tile row,
+	// sorted by their left edge
+	Common::Array<uint> prevRow, curRow;
+
+	for (int y = 0; y < _dirtyTilesH; ++y) {
+		const byte *row = &_dirtyTiles[y * _dirtyTilesW];
+		uint prev = 0;
+		curRow.clear();
+
+		int x = 0;
+		while (x < _dirtyTilesW) {
+			if (!row[x]) {
+				++x;
+				continue;
+			}
+
+			const int start = x;
+			while (x < _dirtyTilesW && row[x])
+				++x;
+
+			const Common::Rect run(start << kDirtyTileShift, y << kDirtyTileShift,
+				x << kDirtyTileShift, (y + 1) << kDirtyTileShift);
 
-	return !destRect.isEmpty();
+			while (prev < prevRow.size() && rects[prevRow[prev]].left < run.left)
+				++prev;
+
+			if (prev < prevRow.size() && rects[prevRow[prev]].left == run.left &&
+					rects[prevRow[prev]].right == run.right) {
+				// Same extent as a rect on the previous row, so extend it
+				rects[prevRow[prev]].bottom = run.bottom;
+				curRow.push_back(prevRow[prev]);
+			} else {
+				curRow.push_back(rects.size());
+				rects.push_back(run);
+			}
+		}
+
+		prevRow = curRow;
+	}
 }
 
 void Screen::getPalette(byte palette[PALETTE_SIZE]) {
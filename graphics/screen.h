@@ -25,7 +25,7 @@
 
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
-#include "common/list.h"
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Graphics {
@@ -41,20 +41,40 @@ namespace Graphics {
  */
 class Screen : public ManagedSurface {
 private:
+	enum {
+		/** Size of the dirty tiles is 1 << kDirtyTileShift pixels */
+		kDirtyTileShift = 4
+	};
+
+	/**
+	 * One entry per tile of the screen, set when anything in that tile
+	 * was modified during the current frame
+	 */
+	Common::Array<byte> _dirtyTiles;
+	int _dirtyTilesW, _dirtyTilesH;
+
 	/**
-	 * List of affected areas of the screen
+	 * Number of dirty tiles
 	 */
-	Common::List<Common::Rect> _dirtyRects;
+	uint _dirtyTileCount;
+
+	/**
+	 * Statistics of the last call to update()
+	 */
+	uint _updateRectCount;
+	uint32 _updatePixelCount;
 private:
 	/**
-	* Merges together overlapping dirty areas of the screen
-	*/
-	void mergeDirtyRects();
+	 * Makes sure the dirty tiles cover the given area, growing them if needed
+	 */
+	void ensureDirtyTiles(int right, int bottom);
 
 	/**
-	* Returns the union of two dirty area rectangles
-	*/
-	bool unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2);
+	 * Builds the list of areas to copy to the physical screen out of the
+	 * dirty tiles. Horizontal runs of dirty tiles are joined, and runs with
+	 * the same extent on consecutive tile rows are merged together.
+	 */
+	void getDirtyRects(Common::Array<Common::Rect> &rects) const;
 protected:
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
@@ -69,7 +89,7 @@ public:
 	/**
 	 * Returns true if there are any pending screen updates (dirty areas)
 	 */
-	bool isDirty() const { return !_dirtyRects.empty(); }
+	bool isDirty() const { return _dirtyTileCount != 0; }
 
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
@@ -80,13 +100,23 @@ public:
 	/**
 	 * Clear the current dirty rects list
 	 */
-	virtual void clearDirtyRects() { _dirtyRects.clear(); }
+	virtual void clearDirtyRects();
 
 	/**
 	 * Updates the screen by copying any affected areas to the system
 	 */
 	virtual void update();
 
+	/**
+	 * Returns the number of rectangles copied to the system by the last update
+	 */
+	uint getUpdateRectCount() const { return _updateRectCount; }
+
+	/**
+	 * Returns the number of pixels copied to the system by the last update
+	 */
+	uint32 getUpdatePixelCount() const { return _updatePixelCount; }
+
 	/**
 	 * Return the currently active palette
 	 */
@@ -90,6 +90,8 @@ struct WidgetDrawData {
 
 	bool _buffer;
 
+	/** Whether the result of drawing all the steps may be cached */
+	bool _cacheable;
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -99,6 +101,14 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Checks whether the output of this DrawData item only depends on its
+	 * size and on what is below it, so it can be stored in the draw cache.
+	 * Items drawing outside of their area (i.e. filling the whole surface)
+	 * cannot be cached.
+	 */
+	void calcCacheable();
 };
 
 class ThemeItem {
@@ -199,6 +209,179 @@ protected:
 	const Common::Rect _clip;
 };
 
+/**
+ * Cache of rendered DrawData items.
+ *
+ * Each entry stores the contents of the widget area before and after all the
+ * steps of a DrawData item were drawn. When the same item is drawn again with
+ * the same size, dynamic data and renderer state over an identical background,
+ * the stored result is blitted instead of computing the gradients, rounded
+ * corners and shadows again.
+ */
+class ThemeDrawCache {
+public:
+	enum {
+		kFlagClip = 1 << 0,
+		kFlagShadows = 1 << 1,
+		kFlagOddX = 1 << 2,
+		kFlagOddY = 1 << 3
+	};
+
+	struct Key {
+		const WidgetDrawData *data;
+		int16 width, height;
+		uint32 dynamicData;
+		uint32 colors[Graphics::VectorRenderer::kColorStateSize];
+		byte flags;
+
+		bool operator==(const Key &other) const {
+			return data == other.data && width == other.width && height == other.height &&
+			       dynamicData == other.dynamicData && flags == other.flags &&
+			       !memcmp(colors, other.colors, sizeof(colors));
+		}
+	};
+
+	struct Entry {
+		Key key;
+		Graphics::Surface before;
+		Graphics::Surface after;
+
+		uint32 size() const { return before.pitch * before.h + after.pitch * after.h; }
+	};
+
+	ThemeDrawCache() : _size(0), _hits(0), _misses(0) {}
+	~ThemeDrawCache() { clear(); }
+
+	/**
+	 * Blits the cached rendering for the given key into the area r of surface,
+	 * provided the current background there matches the cached one.
+	 *
+	 * @return true if the cached rendering was used.
+	 */
+	bool draw(const Key &key, Graphics::Surface &surface, const Common::Rect &r);
+
+	/**
+	 * Starts a new cache entry, storing the background of the area r before
+	 * drawing. Returns 0 if the area is too big to be cached.
+	 */
+	Entry *begin(const Key &key, const Graphics::Surface &surface, const Common::Rect &r);
+
+	/**
+	 * Stores the result of drawing into an entry created by begin() and
+	 * inserts it into the cache, evicting the least recently used entries
+	 * if needed.
+	 */
+	void finish(Entry *entry, const Graphics::Surface &surface, const Common::Rect &r);
+
+	void clear();
+
+private:
+	/** Maximum amount of memory used by all the cached renderings */
+	static const uint32 kMaxSize = 4 * 1024 * 1024;
+
+	typedef Common::List<Entry *> EntryList;
+
+	static void grab(Graphics::Surface &dst, const Graphics::Surface &surface, const Common::Rect &r);
+	static bool compare(const Graphics::Surface &src, const Graphics::Surface &surface, const Common::Rect &r);
+	void freeEntry(Entry *entry);
+
+	/** Cached renderings, most recently used first */
+	EntryList _entries;
+	uint32 _size;
+
+	uint32 _hits;
+	uint32 _misses;
+};
+
+bool ThemeDrawCache::draw(const Key &key, Graphics::Surface &surface, const Common::Rect &r) {
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		Entry *entry = *i;
+		if (!(entry->key == key))
+			continue;
+
+		if (!compare(entry->before, surface, r))
+			break;
+
+		_entries.erase(i);
+		_entries.push_front(entry);
+
+		surface.copyRectToSurface(entry->after, r.left, r.top, Common::Rect(r.width(), r.height()));
+		++_hits;
+		return true;
+	}
+
+	++_misses;
+	return false;
+}
+
+ThemeDrawCache::Entry *ThemeDrawCache::begin(const Key &key, const Graphics::Surface &surface, const Common::Rect &r) {
+	if ((uint32)r.width() * r.height() * surface.format.bytesPerPixel * 2 > kMaxSize / 2)
+		return 0;
+
+	// An entry with the same key but a different background is replaced
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if ((*i)->key == key) {
+			_size -= (*i)->size();
+			freeEntry(*i);
+			_entries.erase(i);
+			break;
+		}
+	}
+
+	Entry *entry = new Entry;
+	entry->key = key;
+	grab(entry->before, surface, r);
+	return entry;
+}
+
+void ThemeDrawCache::finish(Entry *entry, const Graphics::Surface &surface, const Common::Rect &r) {
+	grab(entry->after, surface, r);
+
+	_entries.push_front(entry);
+	_size += entry->size();
+
+	while (_size > kMaxSize && !_entries.empty()) {
+		Entry *last = _entries.back();
+		_entries.pop_back();
+		_size -= last->size();
+		freeEntry(last);
+	}
+}
+
+void ThemeDrawCache::clear() {
+	if (_hits || _misses)
+		debug(6, "ThemeDrawCache: %d hits, %d misses, %d bytes in %d entries", _hits, _misses, _size, _entries.size());
+
+	for (EntryList::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		freeEntry(*i);
+
+	_entries.clear();
+	_size = 0;
+	_hits = _misses = 0;
+}
+
+void ThemeDrawCache::grab(Graphics::Surface &dst, const Graphics::Surface &surface, const Common::Rect &r) {
+	dst.create(r.width(), r.height(), surface.format);
+	dst.copyRectToSurface(surface, 0, 0, r);
+}
+
+bool ThemeDrawCache::compare(const Graphics::Surface &src, const Graphics::Surface &surface, const Common::Rect &r) {
+	const uint rowSize = r.width() * surface.format.bytesPerPixel;
+
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(src.getBasePtr(0, y), surface.getBasePtr(r.left, r.top + y), rowSize))
+			return false;
+	}
+
+	return true;
+}
+
+void ThemeDrawCache::freeEntry(Entry *entry) {
+	entry->before.free();
+	entry->after.free();
+	delete entry;
+}
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -275,11 +458,8 @@ void ThemeItemDrawData::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step)
-			_engine->renderer()->drawStep(_area, *step, _dynamicData);
-	}
+	if (draw)
+		_engine->drawDrawData(_data, _area, extendedRect, 0, _dynamicData);
 
 	_engine->addDirtyRect(extendedRect);
 }
@@ -292,12 +472,8 @@ void ThemeItemDrawDataClip::drawSelf(bool draw, bool restore) {
 	if (restore)
 		_engine->restoreBackground(extendedRect);
 
-	if (draw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = _data->_steps.begin(); step != _data->_steps.end(); ++step) {
-			_engine->renderer()->drawStepClip(_area, _clip, *step, _dynamicData);
-		}
-	}
+	if (draw)
+		_engine->drawDrawData(_data, _area, extendedRect, &_clip, _dynamicData);
 
 	extendedRect.clip(_clip);
 
@@ -369,6 +545,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_font(0), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
 	_cursor(0) {
 
+	_drawCache = new ThemeDrawCache();
+
 	_system = g_system;
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
@@ -438,6 +616,7 @@ ThemeEngine::~ThemeEngine() {
 	}
 	_abitmaps.clear();
 
+	delete _drawCache;
 	delete _parser;
 	delete _themeEval;
 	delete[] _cursor;
@@ -634,6 +813,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	_drawCache->clear();
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -659,11 +840,67 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_backgroundOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	_cacheable = !_steps.empty();
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE)
+			_cacheable = false;
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	r.clip(_screen.w, _screen.h);
 	_vectorRenderer->blitSurface(&_backBuffer, r);
 }
 
+void ThemeEngine::drawDrawData(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect, const Common::Rect *clip, uint32 dynamicData) {
+	Graphics::Surface *surface = _vectorRenderer->getActiveSurface();
+	ThemeDrawCache::Entry *entry = 0;
+	Common::List<Graphics::DrawStep>::const_iterator step;
+
+	// Only areas which are fully drawn may be cached, since the rendering
+	// is stored relative to the area.
+	if (data->_cacheable && surface && Common::Rect(surface->w, surface->h).contains(extendedRect) &&
+	        (!clip || clip->contains(extendedRect))) {
+		ThemeDrawCache::Key key;
+		key.data = data;
+		key.width = area.width();
+		key.height = area.height();
+		key.dynamicData = dynamicData;
+		_vectorRenderer->getColorState(key.colors);
+		key.flags = 0;
+		if (clip)
+			key.flags |= ThemeDrawCache::kFlagClip;
+		if (!_vectorRenderer->shadowsDisabled())
+			key.flags |= ThemeDrawCache::kFlagShadows;
+		// Gradient dithering depends on the parity of the coordinates
+		if (area.left & 1)
+			key.flags |= ThemeDrawCache::kFlagOddX;
+		if (area.top & 1)
+			key.flags |= ThemeDrawCache::kFlagOddY;
+
+		if (_drawCache->draw(key, *surface, extendedRect)) {
+			for (step = data->_steps.begin(); step != data->_steps.end(); ++step)
+				_vectorRenderer->applyStepState(*step, dynamicData);
+			return;
+		}
+
+		entry = _drawCache->begin(key, *surface, extendedRect);
+	}
+
+	for (step = data->_steps.begin(); step != data->_steps.end(); ++step) {
+		if (clip)
+			_vectorRenderer->drawStepClip(area, *clip, *step, dynamicData);
+		else
+			_vectorRenderer->drawStep(area, *step, dynamicData);
+	}
+
+	if (entry)
+		_drawCache->finish(entry, *surface, extendedRect);
+}
+
 
 
 /**********************************************************
@@ -860,6 +1097,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_buffer = kDrawDataDefaults[id].buffer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cacheable = false;
 
 	return true;
 }
@@ -890,11 +1128,15 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s'", kDrawDataDefaults[i].name);
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 }
 
 void ThemeEngine::unloadTheme() {
+	// Cached renderings refer to the DrawData items of the theme
+	_drawCache->clear();
+
 	if (!_themeOk)
 		return;
 
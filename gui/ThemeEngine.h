@@ -53,6 +53,7 @@ struct TextDrawData;
 struct TextColorData;
 class Dialog;
 class GuiObject;
+class ThemeDrawCache;
 class ThemeEval;
 class ThemeItem;
 class ThemeParser;
@@ -581,6 +582,20 @@ public:
 	 */
 	void restoreBackground(Common::Rect r);
 
+	/**
+	 * Draws all the steps of a DrawData item on the active surface of the
+	 * renderer. If the same item was already drawn with the same size over
+	 * an identical background, the cached result is blitted instead.
+	 *
+	 * @param data DrawData item to draw.
+	 * @param area Area of the widget.
+	 * @param extendedRect Area touched by the drawing, including shadows.
+	 * @param clip Clipping area, or 0 to draw unclipped.
+	 * @param dynamicData Dynamic data of the steps.
+	 */
+	void drawDrawData(const WidgetDrawData *data, const Common::Rect &area, const Common::Rect &extendedRect,
+	                  const Common::Rect *clip, uint32 dynamicData);
+
 	const Common::String &getThemeName() const { return _themeName; }
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
@@ -737,6 +752,9 @@ protected:
 	/** Queue with all the drawing that must be done to the screen */
 	Common::List<ThemeItem *> _screenQueue;
 
+	/** Cache of rendered DrawData items */
+	ThemeDrawCache *_drawCache;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
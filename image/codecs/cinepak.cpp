@@ -129,6 +129,45 @@ struct CodebookConverterRaw {
 	}
 };
 
+/**
+ * Codebook converter for 16bpp and 32bpp output, using the codebooks
+ * already converted to the output pixel format.
+ */
+struct CodebookConverterRGB {
+	template<typename PixelInt>
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+		const uint32 *colors = strip.v1_rgb + (codebookIndex << 2);
+		const PixelInt color0 = colors[0];
+		const PixelInt color1 = colors[1];
+		const PixelInt color2 = colors[2];
+		const PixelInt color3 = colors[3];
+
+		rows[0][0] = color0; rows[0][1] = color0; rows[0][2] = color1; rows[0][3] = color1;
+		rows[1][0] = color0; rows[1][1] = color0; rows[1][2] = color1; rows[1][3] = color1;
+		rows[2][0] = color2; rows[2][1] = color2; rows[2][2] = color3; rows[2][3] = color3;
+		rows[3][0] = color2; rows[3][1] = color2; rows[3][2] = color3; rows[3][3] = color3;
+	}
+
+	template<typename PixelInt>
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
+		const uint32 *colors = strip.v4_rgb + (codebookIndex[0] << 2);
+		rows[0][0] = colors[0]; rows[0][1] = colors[1];
+		rows[1][0] = colors[2]; rows[1][1] = colors[3];
+
+		colors = strip.v4_rgb + (codebookIndex[1] << 2);
+		rows[0][2] = colors[0]; rows[0][3] = colors[1];
+		rows[1][2] = colors[2]; rows[1][3] = colors[3];
+
+		colors = strip.v4_rgb + (codebookIndex[2] << 2);
+		rows[2][0] = colors[0]; rows[2][1] = colors[1];
+		rows[3][0] = colors[2]; rows[3][1] = colors[3];
+
+		colors = strip.v4_rgb + (codebookIndex[3] << 2);
+		rows[2][2] = colors[0]; rows[2][3] = colors[1];
+		rows[3][2] = colors[2]; rows[3][3] = colors[3];
+	}
+};
+
 /**
  * Codebook converter that dithers in VFW-style
  */
@@ -435,9 +474,15 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
-			// Copy the QuickTime dither tables
-			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
-			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
+			if (_ditherType == kDitherTypeQT) {
+				// Copy the QuickTime dither tables
+				memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
+				memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
+			} else if (_pixelFormat.bytesPerPixel != 1) {
+				// Copy the converted codebooks
+				memcpy(_curFrame.strips[i].v1_rgb, _curFrame.strips[i - 1].v1_rgb, sizeof(_curFrame.strips[i].v1_rgb));
+				memcpy(_curFrame.strips[i].v4_rgb, _curFrame.strips[i - 1].v4_rgb, sizeof(_curFrame.strips[i].v4_rgb));
+			}
 		}
 
 		_curFrame.strips[i].id = stream.readUint16BE();
@@ -533,9 +578,12 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Dither the codebook if we're dithering for QuickTime,
+			// or convert it once to the output format otherwise
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else if (_pixelFormat.bytesPerPixel != 1)
+				convertCodebookRGB(strip, codebookType, i);
 		}
 	}
 }
@@ -598,13 +646,21 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 	}
 }
 
+void CinepakDecoder::convertCodebookRGB(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	const CinepakCodebook &codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook[codebookIndex] : _curFrame.strips[strip].v4_codebook[codebookIndex];
+	uint32 *output = ((codebookType == 1) ? _curFrame.strips[strip].v1_rgb : _curFrame.strips[strip].v4_rgb) + (codebookIndex << 2);
+
+	for (int i = 0; i < 4; i++)
+		output[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
+}
+
 void CinepakDecoder::decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_curFrame.surface->format.bytesPerPixel == 1) {
 		decodeVectorsTmpl<byte, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterRGB>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRaw>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterRGB>(_curFrame, _clipTable, _colorMap, stream, strip, chunkID, chunkSize);
 	}
 }
 
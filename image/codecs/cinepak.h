@@ -47,6 +47,7 @@ struct CinepakStrip {
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
+	uint32 v1_rgb[256 * 4], v4_rgb[256 * 4]; // The codebooks in the output pixel format
 };
 
 struct CinepakFrame {
@@ -100,6 +101,7 @@ private:
 	byte findNearestRGB(int index) const;
 	void ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex);
+	void convertCodebookRGB(uint16 strip, byte codebookType, uint16 codebookIndex);
 };
 
 } // End of namespace Image
@@ -33,6 +33,7 @@
 #include "common/system.h"
 #include "common/debug.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 #include "common/huffman.h"
 
 #include "graphics/yuv_to_rgb.h"
@@ -51,9 +52,13 @@ SVQ1Decoder::SVQ1Decoder(uint16 width, uint16 height) {
 	_frameWidth = _frameHeight = 0;
 	_surface = 0;
 
-	_last[0] = 0;
-	_last[1] = 0;
-	_last[2] = 0;
+	for (int i = 0; i < 3; i++) {
+		_last[i] = _current[i] = 0;
+		_lastSize[i] = _currentSize[i] = 0;
+	}
+
+	_decodedFrames = 0;
+	_decodeTime = 0;
 
 	// Setup Variable Length Code Tables
 	_blockType = new Common::Huffman(0, 4, s_svq1BlockTypeCodes, s_svq1BlockTypeLengths);
@@ -74,9 +79,10 @@ SVQ1Decoder::~SVQ1Decoder() {
 		delete _surface;
 	}
 
-	delete[] _last[0];
-	delete[] _last[1];
-	delete[] _last[2];
+	for (int i = 0; i < 3; i++) {
+		delete[] _last[i];
+		delete[] _current[i];
+	}
 
 	delete _blockType;
 	delete _intraMean;
@@ -94,7 +100,11 @@ SVQ1Decoder::~SVQ1Decoder() {
 const Graphics::Surface *SVQ1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
 	debug(1, "SVQ1Decoder::decodeImage()");
 
-	Common::BitStream32BEMSB frameData(stream);
+	const uint32 startTime = debugLevelSet(2) ? g_system->getMillis(true) : 0;
+
+	// Read the whole frame into memory, so that the VLC reads below can
+	// peek at the next bits without going back to the stream
+	Common::BitStreamMemory32BEMSB frameData(stream);
 
 	uint32 frameCode = frameData.getBits(22);
 	debug(1, " frameCode: %d", frameCode);
@@ -190,21 +200,31 @@ const Graphics::Surface *SVQ1Decoder::decodeFrame(Common::SeekableReadStream &st
 
 	// Decode Y, U and V component planes
 	for (int i = 0; i < 3; i++) {
-		uint width, height, pitch;
+		uint width, height, pitch, size;
 		if (i == 0) {
 			width = yWidth;
 			height = yHeight;
 			pitch = width;
-			current[i] = new byte[width * height];
+			size = width * height;
 		} else {
 			width = uvWidth;
 			height = uvHeight;
 			pitch = uvPitch;
 
 			// Add an extra row here. See below for more information.
-			current[i] = new byte[pitch * (height + 1)];
+			size = pitch * (height + 1);
+		}
+
+		// Every block of the plane gets written, so the buffer of the
+		// frame before the last one can be reused as is
+		if (_currentSize[i] != size) {
+			delete[] _current[i];
+			_current[i] = new byte[size];
+			_currentSize[i] = size;
 		}
 
+		current[i] = _current[i];
+
 		if (frameType == 0) { // I Frame
 			// Keyframe (I)
 			byte *currentP = current[i];
@@ -273,10 +293,17 @@ const Graphics::Surface *SVQ1Decoder::decodeFrame(Common::SeekableReadStream &st
 	// Finally, actually do the conversion ;)
 	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleFull, current[0], current[1], current[2], yWidth, yHeight, yWidth, uvPitch);
 
-	// Store the current surfaces for later and free the old ones
+	// Store the current planes for later and reuse the old ones
 	for (int i = 0; i < 3; i++) {
-		delete[] _last[i];
-		_last[i] = current[i];
+		SWAP(_last[i], _current[i]);
+		SWAP(_lastSize[i], _currentSize[i]);
+	}
+
+	if (debugLevelSet(2)) {
+		_decodeTime += g_system->getMillis(true) - startTime;
+		_decodedFrames++;
+		debug(2, "SVQ1Decoder: %d frames decoded in %d ms, %d.%02d ms per frame", _decodedFrames, _decodeTime,
+		      _decodeTime / _decodedFrames, (_decodeTime * 100 / _decodedFrames) % 100);
 	}
 
 	return _surface;
@@ -527,28 +554,32 @@ void SVQ1Decoder::svq1SkipBlock(byte *current, byte *previous, int pitch, int x,
 	}
 }
 
+// The motion compensation works on a whole 8 pixel row at once, with all
+// the byte lanes of a 64-bit integer computed in parallel.
+
+// Replicate a 32-bit byte mask to both halves of a 64-bit integer
+static inline uint64 byteMask64(uint32 mask) {
+	return ((uint64)mask << 32) | mask;
+}
+
 void SVQ1Decoder::putPixels8C(byte *block, const byte *pixels, int lineSize, int h) {
 	for (int i = 0; i < h; i++) {
-		*((uint32 *)block) = READ_UINT32(pixels);
-		*((uint32 *)(block + 4)) = READ_UINT32(pixels + 4);
+		WRITE_UINT64(block, READ_UINT64(pixels));
 		pixels += lineSize;
 		block += lineSize;
 	}
 }
 
-static inline uint32 rndAvg32(uint32 a, uint32 b) {
-	return (a | b) - (((a ^ b) & ~0x01010101) >> 1);
+static inline uint64 rndAvg64(uint64 a, uint64 b) {
+	return (a | b) - (((a ^ b) & byteMask64(0xFEFEFEFE)) >> 1);
 }
 
 void SVQ1Decoder::putPixels8L2(byte *dst, const byte *src1, const byte *src2,
 		int dstStride, int srcStride1, int srcStride2, int h) {
 	for (int i = 0; i < h; i++) {
-		uint32 a = READ_UINT32(&src1[srcStride1 * i]);
-		uint32 b = READ_UINT32(&src2[srcStride2 * i]);
-		*((uint32 *)&dst[dstStride * i]) = rndAvg32(a, b);
-		a = READ_UINT32(&src1[srcStride1 * i + 4]);
-		b = READ_UINT32(&src2[srcStride2 * i + 4]);
-		*((uint32 *)&dst[dstStride * i + 4]) = rndAvg32(a, b);
+		uint64 a = READ_UINT64(&src1[srcStride1 * i]);
+		uint64 b = READ_UINT64(&src2[srcStride2 * i]);
+		WRITE_UINT64(&dst[dstStride * i], rndAvg64(a, b));
 	}
 }
 
@@ -561,33 +592,33 @@ void SVQ1Decoder::putPixels8Y2C(byte *block, const byte *pixels, int lineSize, i
 }
 
 void SVQ1Decoder::putPixels8XY2C(byte *block, const byte *pixels, int lineSize, int h) {
-	for (int j = 0; j < 2; j++) {
-		uint32 a = READ_UINT32(pixels);
-		uint32 b = READ_UINT32(pixels + 1);
-		uint32 l0 = (a & 0x03030303UL) + (b & 0x03030303UL) + 0x02020202UL;
-		uint32 h0 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-
+	const uint64 lowMask = byteMask64(0x03030303);
+	const uint64 highMask = byteMask64(0xFCFCFCFC);
+	const uint64 rounding = byteMask64(0x02020202);
+	const uint64 resultMask = byteMask64(0x0F0F0F0F);
+
+	uint64 a = READ_UINT64(pixels);
+	uint64 b = READ_UINT64(pixels + 1);
+	uint64 l0 = (a & lowMask) + (b & lowMask) + rounding;
+	uint64 h0 = ((a & highMask) >> 2) + ((b & highMask) >> 2);
+
+	pixels += lineSize;
+
+	for (int i = 0; i < h; i += 2) {
+		a = READ_UINT64(pixels);
+		b = READ_UINT64(pixels + 1);
+		uint64 l1 = (a & lowMask) + (b & lowMask);
+		uint64 h1 = ((a & highMask) >> 2) + ((b & highMask) >> 2);
+		WRITE_UINT64(block, h0 + h1 + (((l0 + l1) >> 2) & resultMask));
 		pixels += lineSize;
-
-		for (int i = 0; i < h; i += 2) {
-			a = READ_UINT32(pixels);
-			b = READ_UINT32(pixels + 1);
-			uint32 l1 = (a & 0x03030303UL) + (b & 0x03030303UL);
-			uint32 h1 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-			*((uint32 *)block) = h0 + h1 + (((l0 + l1) >> 2) & 0x0F0F0F0FUL);
-			pixels += lineSize;
-			block += lineSize;
-			a = READ_UINT32(pixels);
-			b = READ_UINT32(pixels + 1);
-			l0 = (a & 0x03030303UL) + (b & 0x03030303UL) + 0x02020202UL;
-			h0 = ((a & 0xFCFCFCFCUL) >> 2) + ((b & 0xFCFCFCFCUL) >> 2);
-			*((uint32 *)block) = h0 + h1 + (((l0 + l1) >> 2) & 0x0F0F0F0FUL);
-			pixels += lineSize;
-			block += lineSize;
-		}
-
-		pixels += 4 - lineSize * (h + 1);
-		block += 4 - lineSize * h;
+		block += lineSize;
+		a = READ_UINT64(pixels);
+		b = READ_UINT64(pixels + 1);
+		l0 = (a & lowMask) + (b & lowMask) + rounding;
+		h0 = ((a & highMask) >> 2) + ((b & highMask) >> 2);
+		WRITE_UINT64(block, h0 + h1 + (((l0 + l1) >> 2) & resultMask));
+		pixels += lineSize;
+		block += lineSize;
 	}
 }
 
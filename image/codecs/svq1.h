@@ -51,7 +51,12 @@ private:
 	uint16 _width, _height;
 	uint16 _frameWidth, _frameHeight;
 
-	byte *_last[3];
+	byte *_last[3], *_current[3];
+	uint32 _lastSize[3], _currentSize[3];
+
+	// Decoding time statistics, shown at debug level 2
+	uint32 _decodedFrames;
+	uint32 _decodeTime;
 
 	Common::Huffman *_blockType;
 	Common::Huffman *_intraMultistage[6];
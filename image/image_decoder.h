@@ -36,6 +36,24 @@ struct Surface;
 
 namespace Image {
 
+/**
+ * Receives the rows of an image while it is being decoded, for decoders
+ * which support it.
+ */
+class ImageRowListener {
+public:
+	virtual ~ImageRowListener() {}
+
+	/**
+	 * Called when rows of the image are completely decoded
+	 *
+	 * @param surface the surface the image is decoded to
+	 * @param top     the first decoded row
+	 * @param count   the number of decoded rows
+	 */
+	virtual void rowsDecoded(const Graphics::Surface &surface, uint16 top, uint16 count) = 0;
+};
+
 /**
  * A representation of an image decoder that maintains ownership of the surface
  * and palette it decodes to.
@@ -59,6 +77,35 @@ public:
 	 */
 	virtual bool loadStream(Common::SeekableReadStream &stream) = 0;
 
+	/**
+	 * Start loading an image from the specified stream, to decode it in
+	 * several steps with continueLoading()
+	 *
+	 * This allows spreading the decoding of large images over several
+	 * frames. The stream has to remain valid until isLoading() returns
+	 * false, and getSurface() returns the partially decoded image until
+	 * then.
+	 *
+	 * The default implementation loads the whole image at once.
+	 *
+	 * @param stream the input stream
+	 * @return whether loading the file could be started
+	 */
+	virtual bool startLoading(Common::SeekableReadStream &stream) { return loadStream(stream); }
+
+	/**
+	 * Decode the next rows of the image being loaded
+	 *
+	 * @param rowCount the maximum number of rows to decode
+	 */
+	virtual void continueLoading(uint rowCount) {}
+
+	/**
+	 * Query if an image started with startLoading() is not completely
+	 * decoded yet.
+	 */
+	virtual bool isLoading() const { return false; }
+
 	/**
 	 * Destroy this decoder's surface and palette
 	 *
@@ -0,0 +1,208 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "image/imagecache.h"
+
+#include "common/file.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+
+#include "image/image_decoder.h"
+
+namespace Image {
+
+CachedImage::CachedImage(const ImageDecoder &decoder, const Graphics::PixelFormat &format) :
+		_palette(0), _paletteStartIndex(0), _paletteColorCount(0) {
+	const Graphics::Surface *surface = decoder.getSurface();
+	assert(surface);
+
+	if (format.bytesPerPixel != 0 && format != surface->format) {
+		// The decoder palette may start at any index, while convertTo()
+		// looks colors up from index 0
+		byte palette[256 * 3];
+		memset(palette, 0, sizeof(palette));
+		if (decoder.hasPalette()) {
+			const uint start = decoder.getPaletteStartIndex();
+			const uint count = MIN<uint>(decoder.getPaletteColorCount(), 256 - start);
+			memcpy(palette + start * 3, decoder.getPalette(), count * 3);
+		}
+
+		Graphics::Surface *converted = surface->convertTo(format, palette);
+		_surface = *converted;
+		delete converted;
+	} else {
+		_surface.copyFrom(*surface);
+
+		if (decoder.hasPalette()) {
+			_paletteStartIndex = decoder.getPaletteStartIndex();
+			_paletteColorCount = decoder.getPaletteColorCount();
+			_palette = new byte[_paletteColorCount * 3];
+			memcpy(_palette, decoder.getPalette(), _paletteColorCount * 3);
+		}
+	}
+}
+
+CachedImage::~CachedImage() {
+	_surface.free();
+	delete[] _palette;
+}
+
+uint32 CachedImage::getSize() const {
+	return _surface.pitch * _surface.h + _paletteColorCount * 3;
+}
+
+ImageCache::ImageCache(uint32 memoryBudget) : _memoryBudget(memoryBudget), _memoryUsage(0) {
+	resetStatistics();
+}
+
+ImageCache::~ImageCache() {
+	clear();
+}
+
+Common::String ImageCache::makeKey(const Common::String &path, const Graphics::PixelFormat &format, const Common::String &params) {
+	Common::String key(path);
+	key.toLowercase();
+
+	// Only the pixel format and the parameters can differ for the same file
+	if (format.bytesPerPixel != 0)
+		key += Common::String::format("|%d%s", format.bytesPerPixel, format.toString().c_str());
+	else
+		key += '|';
+
+	key += '|';
+	key += params;
+	return key;
+}
+
+CachedImagePtr ImageCache::getImage(const Common::String &path, ImageDecoder &decoder,
+                                    const Graphics::PixelFormat &format, const Common::String &params) {
+	CachedImagePtr image = findImage(path, format, params);
+	if (image)
+		return image;
+
+	Common::File file;
+	if (!file.open(path)) {
+		warning("ImageCache: Could not open '%s'", path.c_str());
+		return image;
+	}
+
+	return loadImage(path, file, decoder, format, params);
+}
+
+CachedImagePtr ImageCache::findImage(const Common::String &path, const Graphics::PixelFormat &format, const Common::String &params) {
+	const Common::String key = makeKey(path, format, params);
+	EntryMap::iterator i = _images.find(key);
+
+	if (i == _images.end()) {
+		_statistics.misses++;
+		return CachedImagePtr();
+	}
+
+	_statistics.hits++;
+
+	// Move the entry to the front of the LRU list
+	if (i->_value != _lru.begin()) {
+		const Entry entry = *i->_value;
+		_lru.erase(i->_value);
+		_lru.push_front(entry);
+		i->_value = _lru.begin();
+	}
+
+	return i->_value->image;
+}
+
+CachedImagePtr ImageCache::loadImage(const Common::String &path, Common::SeekableReadStream &stream, ImageDecoder &decoder,
+                                     const Graphics::PixelFormat &format, const Common::String &params) {
+	if (!decoder.loadStream(stream) || !decoder.getSurface()) {
+		warning("ImageCache: Could not decode '%s'", path.c_str());
+		decoder.destroy();
+		return CachedImagePtr();
+	}
+
+	CachedImagePtr image(new CachedImage(decoder, format));
+	decoder.destroy();
+
+	// Images too large for the cache are only given to the caller
+	const uint32 size = image->getSize();
+	if (size > _memoryBudget)
+		return image;
+
+	const Common::String key = makeKey(path, format, params);
+
+	// Replace any image added in the meantime
+	EntryMap::iterator i = _images.find(key);
+	if (i != _images.end())
+		removeEntry(i->_value);
+
+	Common::String lowerPath(path);
+	lowerPath.toLowercase();
+
+	_lru.push_front(Entry(key, lowerPath, image));
+	_images[key] = _lru.begin();
+	_memoryUsage += size;
+
+	evictImages();
+	return image;
+}
+
+void ImageCache::removeEntry(EntryList::iterator entry) {
+	_memoryUsage -= entry->image->getSize();
+	_images.erase(entry->key);
+	_lru.erase(entry);
+}
+
+void ImageCache::evictImages() {
+	while (_memoryUsage > _memoryBudget) {
+		removeEntry(--_lru.end());
+		_statistics.evictions++;
+	}
+}
+
+void ImageCache::removeImages(const Common::String &path) {
+	Common::String lowerPath(path);
+	lowerPath.toLowercase();
+
+	for (EntryList::iterator i = _lru.begin(); i != _lru.end(); ) {
+		EntryList::iterator entry = i++;
+		if (entry->path == lowerPath)
+			removeEntry(entry);
+	}
+}
+
+void ImageCache::clear() {
+	_lru.clear();
+	_images.clear();
+	_memoryUsage = 0;
+}
+
+void ImageCache::setMemoryBudget(uint32 memoryBudget) {
+	_memoryBudget = memoryBudget;
+	evictImages();
+}
+
+void ImageCache::resetStatistics() {
+	_statistics.hits = 0;
+	_statistics.misses = 0;
+	_statistics.evictions = 0;
+}
+
+} // End of namespace Image
@@ -0,0 +1,187 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef IMAGE_IMAGECACHE_H
+#define IMAGE_IMAGECACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Image {
+
+class ImageDecoder;
+
+/**
+ * An image held by an ImageCache.
+ *
+ * Cached images are shared between all users of the cache and must not
+ * be modified.
+ */
+class CachedImage {
+public:
+	/**
+	 * Copy the image of a decoder, converting it to the given format
+	 * unless the format is invalid (has 0 bytes per pixel).
+	 */
+	CachedImage(const ImageDecoder &decoder, const Graphics::PixelFormat &format);
+	~CachedImage();
+
+	const Graphics::Surface &getSurface() const { return _surface; }
+
+	/** Get the palette of a paletted image, or 0 if there is none. */
+	const byte *getPalette() const { return _palette; }
+	byte getPaletteStartIndex() const { return _paletteStartIndex; }
+	uint16 getPaletteColorCount() const { return _paletteColorCount; }
+
+	/** Return the memory used by the image, in bytes. */
+	uint32 getSize() const;
+
+private:
+	Graphics::Surface _surface;
+	byte *_palette;
+	byte _paletteStartIndex;
+	uint16 _paletteColorCount;
+};
+
+typedef Common::SharedPtr<CachedImage> CachedImagePtr;
+
+/**
+ * A cache of decoded images, for engines which load the same image files
+ * several times.
+ *
+ * Images are identified by their file name and by the parameters used to
+ * decode them. When the memory used by the cached images exceeds the
+ * memory budget, the least recently used images are removed from the
+ * cache. Images removed from the cache remain valid for as long as they
+ * are referenced.
+ */
+class ImageCache {
+public:
+	enum {
+		kDefaultMemoryBudget = 16 * 1024 * 1024
+	};
+
+	struct Statistics {
+		uint32 hits;      ///< Number of images found in the cache
+		uint32 misses;    ///< Number of images not found in the cache
+		uint32 evictions; ///< Number of images removed to stay within the budget
+	};
+
+	ImageCache(uint32 memoryBudget = kDefaultMemoryBudget);
+	~ImageCache();
+
+	/**
+	 * Get an image, loading it from the file with the given name through
+	 * SearchMan if it is not in the cache.
+	 *
+	 * @param path    the name of the image file
+	 * @param decoder the decoder to load the image with on a cache miss.
+	 *                The decoder holds no image afterwards.
+	 * @param format  the pixel format to convert the image to, or an
+	 *                invalid format to keep the format of the decoder
+	 * @param params  any other parameters the decoded image depends on,
+	 *                like decoder settings
+	 * @return the image, or an empty pointer if it could not be loaded
+	 */
+	CachedImagePtr getImage(const Common::String &path, ImageDecoder &decoder,
+	                        const Graphics::PixelFormat &format = Graphics::PixelFormat(), const Common::String &params = Common::String());
+
+	/**
+	 * Look up an image in the cache. The parameters are the same as for
+	 * getImage().
+	 *
+	 * @return the image, or an empty pointer if it is not in the cache
+	 */
+	CachedImagePtr findImage(const Common::String &path,
+	                         const Graphics::PixelFormat &format = Graphics::PixelFormat(), const Common::String &params = Common::String());
+
+	/**
+	 * Load an image from a stream and add it to the cache, for images
+	 * which are not opened through SearchMan. This is meant to be used
+	 * after findImage() failed.
+	 *
+	 * @return the image, or an empty pointer if it could not be loaded
+	 */
+	CachedImagePtr loadImage(const Common::String &path, Common::SeekableReadStream &stream, ImageDecoder &decoder,
+	                         const Graphics::PixelFormat &format = Graphics::PixelFormat(), const Common::String &params = Common::String());
+
+	/** Remove all the images decoded from the file with the given name. */
+	void removeImages(const Common::String &path);
+
+	/** Remove all the images from the cache. */
+	void clear();
+
+	/**
+	 * Set the maximum amount of memory used by the cached images, in
+	 * bytes. Images are removed from the cache to meet it.
+	 */
+	void setMemoryBudget(uint32 memoryBudget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+
+	/** Return the amount of memory used by the cached images, in bytes. */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
+	/** Return the number of cached images. */
+	uint getImageCount() const { return _images.size(); }
+
+	const Statistics &getStatistics() const { return _statistics; }
+	void resetStatistics();
+
+private:
+	struct Entry {
+		Common::String key;
+		Common::String path;
+		CachedImagePtr image;
+
+		Entry(const Common::String &k, const Common::String &p, const CachedImagePtr &i) : key(k), path(p), image(i) {}
+	};
+
+	/** The cached images, the most recently used first */
+	typedef Common::List<Entry> EntryList;
+	typedef Common::HashMap<Common::String, EntryList::iterator> EntryMap;
+
+	EntryList _lru;
+	EntryMap _images;
+
+	uint32 _memoryBudget;
+	uint32 _memoryUsage;
+	Statistics _statistics;
+
+	static Common::String makeKey(const Common::String &path, const Graphics::PixelFormat &format, const Common::String &params);
+	void removeEntry(EntryList::iterator entry);
+	void evictImages();
+};
+
+} // End of namespace Image
+
+#endif
@@ -44,7 +44,8 @@ extern "C" {
 
 namespace Image {
 
-JPEGDecoder::JPEGDecoder() : _surface(), _colorSpace(kColorSpaceRGBA) {
+JPEGDecoder::JPEGDecoder() : _surface(), _colorSpace(kColorSpaceRGBA),
+		_outputPixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0), _rowListener(0), _loadState(0) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -55,8 +56,9 @@ const Graphics::Surface *JPEGDecoder::getSurface() const {
 	return &_surface;
 }
 
-void JPEGDecoder::destroy() {
-	_surface.free();
+void JPEGDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+	_outputPixelFormat = format;
 }
 
 const Graphics::Surface *JPEGDecoder::decodeFrame(Common::SeekableReadStream &stream) {
@@ -70,6 +72,16 @@ Graphics::PixelFormat JPEGDecoder::getPixelFormat() const {
 	return _surface.format;
 }
 
+bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	if (!startLoading(stream))
+		return false;
+
+	while (isLoading())
+		continueLoading(_surface.h);
+
+	return true;
+}
+
 #ifdef USE_JPEG
 namespace {
 
@@ -171,16 +183,45 @@ void outputMessage(j_common_ptr cinfo) {
 	debug(3, "libjpeg: %s", buffer);
 }
 
+template<typename PixelInt>
+void convertScanline(PixelInt *dst, const byte *src, uint width, const Graphics::PixelFormat &format) {
+	for (uint x = 0; x < width; x++, src += 3)
+		*dst++ = format.RGBToColor(src[0], src[1], src[2]);
+}
+
 } // End of anonymous namespace
+
+struct JPEGDecoder::LoadState {
+	jpeg_decompress_struct cinfo;
+	jpeg_error_mgr jerr;
+	JSAMPARRAY buffer;
+};
+#else
+struct JPEGDecoder::LoadState {
+};
 #endif
 
-bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
+void JPEGDecoder::destroy() {
+#ifdef USE_JPEG
+	// Abort any unfinished decoding
+	if (_loadState)
+		jpeg_destroy_decompress(&_loadState->cinfo);
+#endif
+
+	delete _loadState;
+	_loadState = 0;
+
+	_surface.free();
+}
+
+bool JPEGDecoder::startLoading(Common::SeekableReadStream &stream) {
 #ifdef USE_JPEG
 	// Reset member variables from previous decodings
 	destroy();
 
-	jpeg_decompress_struct cinfo;
-	jpeg_error_mgr jerr;
+	_loadState = new LoadState();
+	jpeg_decompress_struct &cinfo = _loadState->cinfo;
+	jpeg_error_mgr &jerr = _loadState->jerr;
 
 	// Initialize error handling callbacks
 	cinfo.err = jpeg_std_error(&jerr);
@@ -213,8 +254,8 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Allocate buffers for the output data
 	switch (_colorSpace) {
 	case kColorSpaceRGBA:
-		// We use RGBA8888 in this scenario
-		_surface.create(cinfo.output_width, cinfo.output_height, Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0));
+		// We use RGBA8888 in this scenario, unless another format was requested
+		_surface.create(cinfo.output_width, cinfo.output_height, _outputPixelFormat);
 		break;
 
 	case kColorSpaceYUV:
@@ -227,18 +268,42 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// Allocate buffer for one scanline
 	assert(cinfo.output_components == 3);
 	JDIMENSION pitch = cinfo.output_width * cinfo.output_components;
-	assert(_surface.pitch >= pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	assert(_colorSpace != kColorSpaceYUV || _surface.pitch >= pitch);
+	_loadState->buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void JPEGDecoder::continueLoading(uint rowCount) {
+#ifdef USE_JPEG
+	if (!_loadState)
+		return;
+
+	jpeg_decompress_struct &cinfo = _loadState->cinfo;
+	const JDIMENSION pitch = cinfo.output_width * cinfo.output_components;
+	const JDIMENSION top = cinfo.output_scanline;
+	const bool isDefaultFormat = (_surface.format == Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0));
 
 	// Go through the image data scanline by scanline
-	while (cinfo.output_scanline < cinfo.output_height) {
+	for (; rowCount > 0 && cinfo.output_scanline < cinfo.output_height; rowCount--) {
 		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
 
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+		jpeg_read_scanlines(&cinfo, _loadState->buffer, 1);
 
-		const byte *src = buffer[0];
+		const byte *src = _loadState->buffer[0];
 		switch (_colorSpace) {
 		case kColorSpaceRGBA: {
+			if (!isDefaultFormat) {
+				if (_surface.format.bytesPerPixel == 2)
+					convertScanline<uint16>((uint16 *)dst, src, cinfo.output_width, _surface.format);
+				else
+					convertScanline<uint32>((uint32 *)dst, src, cinfo.output_width, _surface.format);
+				break;
+			}
+
 			for (int remaining = cinfo.output_width; remaining > 0; --remaining) {
 				byte r = *src++;
 				byte g = *src++;
@@ -264,13 +329,17 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		}
 	}
 
-	// We are done with decompressing, thus free all the data
-	jpeg_finish_decompress(&cinfo);
-	jpeg_destroy_decompress(&cinfo);
+	if (_rowListener && cinfo.output_scanline > top)
+		_rowListener->rowsDecoded(_surface, top, cinfo.output_scanline - top);
 
-	return true;
-#else
-	return false;
+	if (cinfo.output_scanline == cinfo.output_height) {
+		// We are done with decompressing, thus free all the data
+		jpeg_finish_decompress(&cinfo);
+		jpeg_destroy_decompress(&cinfo);
+
+		delete _loadState;
+		_loadState = 0;
+	}
 #endif
 }
 
@@ -51,6 +51,9 @@ public:
 	// ImageDecoder API
 	virtual void destroy();
 	virtual bool loadStream(Common::SeekableReadStream &str);
+	virtual bool startLoading(Common::SeekableReadStream &str);
+	virtual void continueLoading(uint rowCount);
+	virtual bool isLoading() const { return _loadState != 0; }
 	virtual const Graphics::Surface *getSurface() const;
 
 	// Codec API
@@ -92,9 +95,31 @@ public:
 	 */
 	void setOutputColorSpace(ColorSpace outSpace) { _colorSpace = outSpace; }
 
+	/**
+	 * Request the pixel format of the RGBA output. The pixels are converted
+	 * while decoding, so no separate conversion pass is needed.
+	 *
+	 * The decoder defaults to RGBA8888.
+	 *
+	 * @param format The pixel format to output, with 2 or 4 bytes per pixel.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format);
+
+	/**
+	 * Set a listener to notify of the decoded rows.
+	 *
+	 * @param listener The listener, or 0 to remove it.
+	 */
+	void setRowListener(ImageRowListener *listener) { _rowListener = listener; }
+
 private:
+	struct LoadState;
+
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
+	Graphics::PixelFormat _outputPixelFormat;
+	ImageRowListener *_rowListener;
+	LoadState *_loadState;
 };
 
 } // End of namespace Image
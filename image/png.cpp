@@ -31,6 +31,7 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -38,21 +39,16 @@
 
 namespace Image {
 
-PNGDecoder::PNGDecoder() : _outputSurface(0), _palette(0), _paletteColorCount(0) {
+PNGDecoder::PNGDecoder() : _outputSurface(0), _palette(0), _paletteColorCount(0), _rowListener(0), _loadState(0) {
 }
 
 PNGDecoder::~PNGDecoder() {
 	destroy();
 }
 
-void PNGDecoder::destroy() {
-	if (_outputSurface) {
-		_outputSurface->free();
-		delete _outputSurface;
-		_outputSurface = 0;
-	}
-	delete[] _palette;
-	_palette = NULL;
+void PNGDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+	_outputPixelFormat = format;
 }
 
 #ifdef USE_PNG
@@ -71,8 +67,49 @@ void pngReadFromStream(png_structp pngPtr, png_bytep data, png_size_t length) {
 	Common::SeekableReadStream *stream = (Common::SeekableReadStream *)readIOptr;
 	stream->read(data, length);
 }
+
+struct PNGDecoder::LoadState {
+	png_structp pngPtr;
+	png_infop infoPtr;
+	png_infop endInfo;
+
+	int passCount;
+	int pass;
+	uint16 row;
+
+	// When converting to another pixel format, the rows are decoded here
+	// first. This holds a single row, or the whole image for interlaced
+	// images.
+	Graphics::Surface decodeSurface;
+	bool isInterlaced;
+};
+#else
+struct PNGDecoder::LoadState {
+};
 #endif
 
+void PNGDecoder::destroy() {
+#ifdef USE_PNG
+	// Abort any unfinished decoding
+	if (_loadState) {
+		png_destroy_read_struct(&_loadState->pngPtr, &_loadState->infoPtr, &_loadState->endInfo);
+		_loadState->decodeSurface.free();
+	}
+#endif
+
+	delete _loadState;
+	_loadState = 0;
+
+	if (_outputSurface) {
+		_outputSurface->free();
+		delete _outputSurface;
+		_outputSurface = 0;
+	}
+	delete[] _palette;
+	_palette = NULL;
+	_paletteColorCount = 0;
+}
+
 /*
  * This code is based on Broken Sword 2.5 engine
  *
@@ -83,6 +120,16 @@ void pngReadFromStream(png_structp pngPtr, png_bytep data, png_size_t length) {
  */
 
 bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
+	if (!startLoading(stream))
+		return false;
+
+	while (isLoading())
+		continueLoading(_outputSurface->h);
+
+	return true;
+}
+
+bool PNGDecoder::startLoading(Common::SeekableReadStream &stream) {
 #ifdef USE_PNG
 	destroy();
 
@@ -131,9 +178,8 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	width = w;
 	height = h;
 
-	// Allocate memory for the final image data.
-	// To keep memory framentation low this happens before allocating memory for temporary image data.
-	_outputSurface = new Graphics::Surface();
+	// The format the image is decoded in
+	Graphics::PixelFormat format;
 
 	// Images of all color formats except PNG_COLOR_TYPE_PALETTE
 	// will be transformed into ARGB images
@@ -142,18 +188,22 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		png_colorp palette = NULL;
 		uint32 success = png_get_PLTE(pngPtr, infoPtr, &palette, &numPalette);
 		if (success != PNG_INFO_PLTE) {
-			png_destroy_read_struct(&pngPtr, &infoPtr, NULL);
+			png_destroy_read_struct(&pngPtr, &infoPtr, &endInfo);
 			return false;
 		}
-		_paletteColorCount = numPalette;
-		_palette = new byte[_paletteColorCount * 3];
+		_paletteColorCount = MIN(numPalette, 256);
+
+		// libpng lets pixels index past a short PLTE chunk, so always
+		// provide all 256 colors for convertRow(), the missing ones black
+		_palette = new byte[256 * 3];
+		memset(_palette, 0, 256 * 3);
 		for (int i = 0; i < _paletteColorCount; i++) {
 			_palette[(i * 3)] = palette[i].red;
 			_palette[(i * 3) + 1] = palette[i].green;
 			_palette[(i * 3) + 2] = palette[i].blue;
 
 		}
-		_outputSurface->create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+		format = Graphics::PixelFormat::createFormatCLUT8();
 		png_set_packing(pngPtr);
 	} else {
 		bool isAlpha = (colorType & PNG_COLOR_MASK_ALPHA);
@@ -161,11 +211,7 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			isAlpha = true;
 			png_set_expand(pngPtr);
 		}
-		_outputSurface->create(width, height, Graphics::PixelFormat(4,
-		                       8, 8, 8, isAlpha ? 8 : 0, 24, 16, 8, 0));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
+		format = Graphics::PixelFormat(4, 8, 8, 8, isAlpha ? 8 : 0, 24, 16, 8, 0);
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -188,47 +234,124 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	}
 
 	// After the transformations have been registered, the image data is read again.
-	png_set_interlace_handling(pngPtr);
+	const int passCount = png_set_interlace_handling(pngPtr);
 	png_read_update_info(pngPtr, infoPtr);
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, NULL, NULL, NULL);
 	width = w;
 	height = h;
 
-	if (interlaceType == PNG_INTERLACE_NONE) {
-		// PNGs without interlacing can simply be read row by row.
-		for (int i = 0; i < height; i++) {
-			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
-		}
+	_loadState = new LoadState();
+	_loadState->pngPtr = pngPtr;
+	_loadState->infoPtr = infoPtr;
+	_loadState->endInfo = endInfo;
+	_loadState->passCount = passCount;
+	_loadState->pass = 0;
+	_loadState->row = 0;
+	_loadState->isInterlaced = (interlaceType != PNG_INTERLACE_NONE);
+
+	// Allocate memory for the final image data.
+	_outputSurface = new Graphics::Surface();
+
+	if (_outputPixelFormat.bytesPerPixel == 0 || _outputPixelFormat == format) {
+		_outputSurface->create(width, height, format);
 	} else {
-		// PNGs with interlacing require us to allocate an auxillary
-		// buffer with pointers to all row starts.
+		_outputSurface->create(width, height, _outputPixelFormat);
+
+		// Interlaced images need all the pixels from the previous passes
+		_loadState->decodeSurface.create(width, _loadState->isInterlaced ? height : 1, format);
+	}
+
+	if (!_outputSurface->getPixels()) {
+		error("Could not allocate memory for output image.");
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void PNGDecoder::continueLoading(uint rowCount) {
+#ifdef USE_PNG
+	if (!_loadState)
+		return;
+
+	Graphics::Surface &decodeSurface = _loadState->decodeSurface;
+	const bool isConverting = (decodeSurface.getPixels() != 0);
+	uint16 top = 0, count = 0;
+
+	for (; rowCount > 0 && _loadState->pass < _loadState->passCount; rowCount--) {
+		const uint16 y = _loadState->row;
+		png_bytep row;
 
-		// Allocate row pointer buffer
-		png_bytep *rowPtr = new png_bytep[height];
-		if (!rowPtr) {
-			error("Could not allocate memory for row pointers.");
+		if (!isConverting)
+			row = (png_bytep)_outputSurface->getBasePtr(0, y);
+		else
+			row = (png_bytep)decodeSurface.getBasePtr(0, _loadState->isInterlaced ? y : 0);
+
+		// PNGs with interlacing are read several times, every pass filling
+		// in more pixels of the rows. Only the last pass completes them.
+		png_read_row(_loadState->pngPtr, row, NULL);
+
+		if (_loadState->pass == _loadState->passCount - 1) {
+			if (isConverting)
+				convertRow(y);
+
+			if (count++ == 0)
+				top = y;
 		}
 
-		// Initialize row pointers
-		for (int i = 0; i < height; i++)
-			rowPtr[i] = (png_bytep)_outputSurface->getBasePtr(0, i);
+		if (++_loadState->row == _outputSurface->h) {
+			_loadState->row = 0;
+			_loadState->pass++;
+		}
+	}
 
-		// Read image data
-		png_read_image(pngPtr, rowPtr);
+	if (_rowListener && count)
+		_rowListener->rowsDecoded(*_outputSurface, top, count);
+
+	if (_loadState->pass == _loadState->passCount) {
+		// Read additional data at the end.
+		png_read_end(_loadState->pngPtr, NULL);
+
+		// Destroy libpng structures
+		png_destroy_read_struct(&_loadState->pngPtr, &_loadState->infoPtr, &_loadState->endInfo);
+
+		// Paletted images converted to another format have no palette
+		if (isConverting && _palette) {
+			delete[] _palette;
+			_palette = NULL;
+			_paletteColorCount = 0;
+		}
 
-		// Free row pointer buffer
-		delete[] rowPtr;
+		decodeSurface.free();
+		delete _loadState;
+		_loadState = 0;
 	}
+#endif
+}
 
-	// Read additional data at the end.
-	png_read_end(pngPtr, NULL);
+void PNGDecoder::convertRow(uint16 y) {
+#ifdef USE_PNG
+	const Graphics::Surface &decodeSurface = _loadState->decodeSurface;
+	const byte *src = (const byte *)decodeSurface.getBasePtr(0, _loadState->isInterlaced ? y : 0);
+	byte *dst = (byte *)_outputSurface->getBasePtr(0, y);
+	const Graphics::PixelFormat &format = _outputSurface->format;
+
+	if (decodeSurface.format.bytesPerPixel != 1) {
+		Graphics::crossBlit(dst, src, _outputSurface->pitch, decodeSurface.pitch, _outputSurface->w, 1, format, decodeSurface.format);
+		return;
+	}
 
-	// Destroy libpng structures
-	png_destroy_read_struct(&pngPtr, &infoPtr, &endInfo);
+	for (int x = 0; x < _outputSurface->w; x++) {
+		const byte *color = _palette + src[x] * 3;
+		const uint32 pixel = format.RGBToColor(color[0], color[1], color[2]);
 
-	return true;
-#else
-	return false;
+		if (format.bytesPerPixel == 2)
+			((uint16 *)dst)[x] = pixel;
+		else
+			((uint32 *)dst)[x] = pixel;
+	}
 #endif
 }
 
@@ -33,6 +33,7 @@
 
 #include "common/scummsys.h"
 #include "common/textconsole.h"
+#include "graphics/pixelformat.h"
 #include "image/image_decoder.h"
 
 namespace Common {
@@ -51,15 +52,46 @@ public:
 	~PNGDecoder();
 
 	bool loadStream(Common::SeekableReadStream &stream);
+	bool startLoading(Common::SeekableReadStream &stream);
+	void continueLoading(uint rowCount);
+	bool isLoading() const { return _loadState != 0; }
 	void destroy();
 	const Graphics::Surface *getSurface() const { return _outputSurface; }
 	const byte *getPalette() const { return _palette; }
 	uint16 getPaletteColorCount() const { return _paletteColorCount; }
+
+	/**
+	 * Request the pixel format of the output. The pixels are converted
+	 * while decoding, so no separate conversion pass is needed. Paletted
+	 * images are converted too, and have no palette then.
+	 *
+	 * By default, paletted images are output in CLUT8 and other images
+	 * in ARGB8888.
+	 *
+	 * @param format The pixel format to output, with 2 or 4 bytes per pixel.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format);
+
+	/**
+	 * Set a listener to notify of the decoded rows. The rows of interlaced
+	 * images are only notified in the last pass.
+	 *
+	 * @param listener The listener, or 0 to remove it.
+	 */
+	void setRowListener(ImageRowListener *listener) { _rowListener = listener; }
+
 private:
+	struct LoadState;
+
+	void convertRow(uint16 y);
+
 	byte *_palette;
 	uint16 _paletteColorCount;
 
 	Graphics::Surface *_outputSurface;
+	Graphics::PixelFormat _outputPixelFormat;
+	ImageRowListener *_rowListener;
+	LoadState *_loadState;
 };
 
 } // End of namespace Image
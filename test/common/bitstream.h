@@ -149,4 +149,81 @@ class BitStreamTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(bs.peekBits(5), 12u);
 		TS_ASSERT(!bs.eos());
 	}
+
+	void test_memory_get_bits() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::BitStreamMemory8MSB bs(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		TS_ASSERT_EQUALS(bs.getBits(3), 3u);
+		TS_ASSERT_EQUALS(bs.pos(), 3u);
+		TS_ASSERT_EQUALS(bs.peekBits(8), 11u);
+		TS_ASSERT_EQUALS(bs.getBits(8), 11u);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT_EQUALS(bs.getBits(5), 2u);
+		TS_ASSERT(bs.eos());
+
+		bs.rewind();
+		TS_ASSERT_EQUALS(bs.pos(), 0u);
+		TS_ASSERT(!bs.eos());
+	}
+
+	void test_memory_get_bits_lsb() {
+		byte contents[] = { 'a', 'b' };
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::BitStreamMemory8LSB bs(ms);
+		TS_ASSERT_EQUALS(bs.getBits(3), 1u);
+		TS_ASSERT_EQUALS(bs.peekBits(8), 76u);
+		bs.skip(8);
+		TS_ASSERT_EQUALS(bs.pos(), 11u);
+		TS_ASSERT_EQUALS(bs.peekBits(5), 12u);
+		TS_ASSERT(!bs.eos());
+	}
+
+	template<class S, class M>
+	void checkSameBits() {
+		byte contents[64];
+		uint32 seed = 0x12345678;
+		for (uint i = 0; i < sizeof(contents); i++) {
+			seed = seed * 1103515245 + 12345;
+			contents[i] = seed >> 16;
+		}
+
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		S stream(ms);
+		M memory(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(stream.size(), memory.size());
+
+		// Read fields of 0 to 32 bits, and the odd alignment
+		uint8 n = 0;
+		while (stream.size() - stream.pos() >= n) {
+			TS_ASSERT_EQUALS(stream.peekBits(n), memory.peekBits(n));
+			TS_ASSERT_EQUALS(stream.getBits(n), memory.getBits(n));
+			TS_ASSERT_EQUALS(stream.pos(), memory.pos());
+
+			if (n == 13) {
+				stream.align();
+				memory.align();
+				TS_ASSERT_EQUALS(stream.pos(), memory.pos());
+			}
+
+			n = (n + 1) % 33;
+		}
+	}
+
+	void test_memory_same_as_stream() {
+		checkSameBits<Common::BitStream8MSB, Common::BitStreamMemory8MSB>();
+		checkSameBits<Common::BitStream8LSB, Common::BitStreamMemory8LSB>();
+		checkSameBits<Common::BitStream16LEMSB, Common::BitStreamMemory16LEMSB>();
+		checkSameBits<Common::BitStream16LELSB, Common::BitStreamMemory16LELSB>();
+		checkSameBits<Common::BitStream16BEMSB, Common::BitStreamMemory16BEMSB>();
+		checkSameBits<Common::BitStream16BELSB, Common::BitStreamMemory16BELSB>();
+		checkSameBits<Common::BitStream32LEMSB, Common::BitStreamMemory32LEMSB>();
+		checkSameBits<Common::BitStream32LELSB, Common::BitStreamMemory32LELSB>();
+		checkSameBits<Common::BitStream32BEMSB, Common::BitStreamMemory32BEMSB>();
+		checkSameBits<Common::BitStream32BELSB, Common::BitStreamMemory32BELSB>();
+	}
 };
@@ -141,4 +141,128 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+	void test_get_long_codes() {
+
+		/*
+		 * Codes longer than the decoder's lookup table have to take
+		 * the bit by bit path. Encoding:
+		 * 0=0
+		 * 1=10
+		 * 2=110
+		 * ...
+		 * 9=1111111110
+		 * 10=11111111110
+		 * 11=11111111111
+		 */
+
+		uint32 codeCount = 12;
+		const uint8 lengths[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 11};
+		const uint32 codes[]  = {0x0, 0x2, 0x6, 0xE, 0x1E, 0x3E, 0x7E, 0xFE, 0x1FE, 0x3FE, 0x7FE, 0x7FF};
+
+		Common::Huffman h(0, codeCount, codes, lengths, 0);
+
+		/*
+		 * 11111111110 0 10 1111111110 = 10 0 1 9
+		 *  = 1111 1111 1100 1011 1111 1110 = 0xFFCBFE
+		 */
+
+		byte input[] = {0xFF, 0xCB, 0xFE};
+		uint32 expected[] = {10, 0, 1, 9};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8MSB bs(ms);
+
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[0]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[1]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[2]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[3]);
+		TS_ASSERT_EQUALS(bs.pos(), 24u);
+	}
+
+	void test_get_lsb_first() {
+
+		/*
+		 * The encoding of test_get_with_full_symbols, read from a
+		 * LSB to MSB bitstream. The codes hold their first bit in
+		 * bit 0 then:
+		 * 0xA=010 -> 0x2
+		 * 0xB=011 -> 0x6
+		 * 0xC=11  -> 0x3
+		 * 0xD=00  -> 0x0
+		 * 0xE=10  -> 0x1
+		 */
+
+		uint32 codeCount = 5;
+		const uint8 lengths[] = {3,3,2,2,2};
+		const uint32 codes[]  = {0x2, 0x6, 0x3, 0x0, 0x1};
+		const uint32 symbols[]  = {0xA, 0xB, 0xC, 0xD, 0xE};
+
+		Common::Huffman h(0, codeCount, codes, lengths, symbols);
+
+		/*
+		 * 010 011 11 00 10 00 00, with each byte filled from bit 0 up
+		 *  = 1111 0010 0000 0100 = 0xF204
+		 */
+
+		byte input[] = {0xF2, 0x04};
+		uint32 expected[] = {0xA, 0xB, 0xC, 0xD, 0xE, 0xD, 0xD};
+
+		Common::MemoryReadStream ms(input, sizeof(input));
+		Common::BitStream8LSB bs(ms);
+
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[0]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[1]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[2]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[3]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[4]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
+		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
+	}
+
+	void test_get_memory_streams() {
+
+		/*
+		 * Memory backed bit streams go through the lookup table
+		 * instead of the bit by bit search, so repeat the MSB first,
+		 * LSB first and long code cases on them.
+		 */
+
+		const uint8 lengths[] = {3,3,2,2,2};
+		const uint32 symbols[]  = {0xA, 0xB, 0xC, 0xD, 0xE};
+		uint32 expected[] = {0xA, 0xB, 0xC, 0xD, 0xE, 0xD, 0xD};
+
+		const uint32 codesMSB[]  = {0x2, 0x3, 0x3, 0x0, 0x2};
+		Common::Huffman hMSB(0, 5, codesMSB, lengths, symbols);
+
+		byte inputMSB[] = {0x4F, 0x20};
+		Common::BitStreamMemory8MSB bsMSB(inputMSB, sizeof(inputMSB));
+
+		for (int i = 0; i < 7; i++)
+			TS_ASSERT_EQUALS(hMSB.getSymbol(bsMSB), expected[i]);
+		TS_ASSERT_EQUALS(bsMSB.pos(), 16u);
+
+		const uint32 codesLSB[]  = {0x2, 0x6, 0x3, 0x0, 0x1};
+		Common::Huffman hLSB(0, 5, codesLSB, lengths, symbols);
+
+		byte inputLSB[] = {0xF2, 0x04};
+		Common::BitStreamMemory8LSB bsLSB(inputLSB, sizeof(inputLSB));
+
+		for (int i = 0; i < 7; i++)
+			TS_ASSERT_EQUALS(hLSB.getSymbol(bsLSB), expected[i]);
+		TS_ASSERT_EQUALS(bsLSB.pos(), 16u);
+
+		const uint8 longLengths[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 11};
+		const uint32 longCodes[]  = {0x0, 0x2, 0x6, 0xE, 0x1E, 0x3E, 0x7E, 0xFE, 0x1FE, 0x3FE, 0x7FE, 0x7FF};
+		Common::Huffman hLong(0, 12, longCodes, longLengths, 0);
+
+		byte inputLong[] = {0xFF, 0xCB, 0xFE};
+		Common::BitStreamMemory8MSB bsLong(inputLong, sizeof(inputLong));
+
+		TS_ASSERT_EQUALS(hLong.getSymbol(bsLong), 10u);
+		TS_ASSERT_EQUALS(hLong.getSymbol(bsLong), 0u);
+		TS_ASSERT_EQUALS(hLong.getSymbol(bsLong), 1u);
+		TS_ASSERT_EQUALS(hLong.getSymbol(bsLong), 9u);
+		TS_ASSERT_EQUALS(bsLong.pos(), 24u);
+	}
 };
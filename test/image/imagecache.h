@@ -0,0 +1,231 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/imagecache.h"
+#include "image/image_decoder.h"
+#include "common/memstream.h"
+
+/**
+ * A decoder for test images: a width and a height byte, followed by the
+ * value all pixels are set to. Optionally adds a two color palette.
+ */
+class TestImageDecoder : public Image::ImageDecoder {
+public:
+	TestImageDecoder(bool withPalette = false, byte paletteStart = 0) :
+			_withPalette(withPalette), _paletteStart(paletteStart), _loads(0) {
+		memset(_palette, 0x55, sizeof(_palette));
+	}
+
+	~TestImageDecoder() {
+		destroy();
+	}
+
+	bool loadStream(Common::SeekableReadStream &stream) {
+		destroy();
+
+		const byte w = stream.readByte();
+		const byte h = stream.readByte();
+		const byte value = stream.readByte();
+		if (stream.eos() || !w || !h)
+			return false;
+
+		_surface.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+		memset(_surface.getPixels(), value, _surface.pitch * h);
+		_loads++;
+		return true;
+	}
+
+	void destroy() {
+		_surface.free();
+	}
+
+	const Graphics::Surface *getSurface() const {
+		return _surface.getPixels() ? &_surface : 0;
+	}
+
+	const byte *getPalette() const { return _withPalette ? _palette : 0; }
+	byte getPaletteStartIndex() const { return _paletteStart; }
+	uint16 getPaletteColorCount() const { return _withPalette ? 2 : 0; }
+
+	void setColor(byte index, byte r, byte g, byte b) {
+		_palette[index * 3 + 0] = r;
+		_palette[index * 3 + 1] = g;
+		_palette[index * 3 + 2] = b;
+	}
+
+	int getLoads() const { return _loads; }
+
+private:
+	Graphics::Surface _surface;
+	byte _palette[2 * 3];
+	bool _withPalette;
+	byte _paletteStart;
+	int _loads;
+};
+
+class ImageCacheTestSuite : public CxxTest::TestSuite {
+	Image::CachedImagePtr load(Image::ImageCache &cache, TestImageDecoder &decoder, const char *path,
+	                              byte w, byte h, byte value, const char *params = "",
+	                              const Graphics::PixelFormat &format = Graphics::PixelFormat()) {
+		const byte data[] = { w, h, value };
+		Common::MemoryReadStream stream(data, sizeof(data));
+		return cache.loadImage(path, stream, decoder, format, params);
+	}
+
+public:
+	void test_find_and_statistics() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder;
+
+		TS_ASSERT(!cache.findImage("a.img"));
+		TS_ASSERT_EQUALS(cache.getStatistics().misses, 1u);
+
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 4, 2, 7);
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS(a->getSurface().w, 4);
+		TS_ASSERT_EQUALS(a->getSurface().h, 2);
+		TS_ASSERT_EQUALS(*(const byte *)a->getSurface().getPixels(), 7);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 1u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 8u);
+
+		// The decoder is emptied after loading
+		TS_ASSERT(!decoder.getSurface());
+
+		// Lookups are case insensitive and hand out the same image
+		Image::CachedImagePtr found = cache.findImage("A.IMG");
+		TS_ASSERT_EQUALS(found.get(), a.get());
+		TS_ASSERT_EQUALS(cache.getStatistics().hits, 1u);
+		TS_ASSERT_EQUALS(cache.getStatistics().misses, 1u);
+
+		// Other parameters or formats are other images
+		TS_ASSERT(!cache.findImage("a.img", Graphics::PixelFormat(), "scaled"));
+		TS_ASSERT(!cache.findImage("a.img", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)));
+		TS_ASSERT_EQUALS(cache.getStatistics().misses, 3u);
+
+		cache.resetStatistics();
+		TS_ASSERT_EQUALS(cache.getStatistics().hits, 0u);
+		TS_ASSERT_EQUALS(cache.getStatistics().misses, 0u);
+		TS_ASSERT_EQUALS(cache.getStatistics().evictions, 0u);
+	}
+
+	void test_palette() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder(true);
+
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 4, 4, 1);
+		TS_ASSERT(a->getPalette());
+		TS_ASSERT_EQUALS(a->getPaletteColorCount(), 2);
+		TS_ASSERT_EQUALS(a->getPalette()[5], 0x55);
+		TS_ASSERT_EQUALS(a->getSize(), 16u + 6u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 22u);
+	}
+
+	void test_palette_conversion() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder(true, 10);
+		decoder.setColor(0, 0xFF, 0x00, 0x00);
+		decoder.setColor(1, 0x00, 0x00, 0xFF);
+
+		// Pixels use the palette index, not the index into the decoder palette
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 2, 2, 11, "", format);
+		TS_ASSERT(a);
+		TS_ASSERT(!a->getPalette());
+		TS_ASSERT_EQUALS(a->getSurface().format, format);
+		TS_ASSERT_EQUALS(*(const uint16 *)a->getSurface().getPixels(), format.RGBToColor(0x00, 0x00, 0xFF));
+
+		// Indices outside the decoder palette are black
+		Image::CachedImagePtr b = load(cache, decoder, "b.img", 2, 2, 3, "", format);
+		TS_ASSERT_EQUALS(*(const uint16 *)b->getSurface().getPixels(), 0);
+	}
+
+	void test_lru_eviction() {
+		Image::ImageCache cache(250);
+		TestImageDecoder decoder;
+
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 10, 10, 1);
+		load(cache, decoder, "b.img", 10, 10, 2);
+
+		// Using a makes b the least recently used image
+		TS_ASSERT(cache.findImage("a.img"));
+
+		load(cache, decoder, "c.img", 10, 10, 3);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 2u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 200u);
+		TS_ASSERT_EQUALS(cache.getStatistics().evictions, 1u);
+		TS_ASSERT(cache.findImage("a.img"));
+		TS_ASSERT(!cache.findImage("b.img"));
+		TS_ASSERT(cache.findImage("c.img"));
+
+		// Lowering the budget evicts right away, the oldest first
+		cache.setMemoryBudget(150);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 1u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 100u);
+		TS_ASSERT(cache.findImage("c.img"));
+		TS_ASSERT(!cache.findImage("a.img"));
+
+		// Evicted images stay valid while referenced
+		TS_ASSERT_EQUALS(a.refCount(), 1);
+		TS_ASSERT_EQUALS(*(const byte *)a->getSurface().getPixels(), 1);
+	}
+
+	void test_too_large() {
+		Image::ImageCache cache(50);
+		TestImageDecoder decoder;
+
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 10, 10, 1);
+		TS_ASSERT(a);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 0u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+		TS_ASSERT_EQUALS(cache.getStatistics().evictions, 0u);
+	}
+
+	void test_refcount() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder;
+
+		Image::CachedImagePtr a = load(cache, decoder, "a.img", 2, 2, 1);
+		TS_ASSERT_EQUALS(a.refCount(), 2);
+
+		{
+			Image::CachedImagePtr b = cache.findImage("a.img");
+			TS_ASSERT_EQUALS(a.refCount(), 3);
+		}
+		TS_ASSERT_EQUALS(a.refCount(), 2);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(a.refCount(), 1);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 0u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 0u);
+	}
+
+	void test_remove_and_replace() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder;
+
+		load(cache, decoder, "a.img", 2, 2, 1);
+		load(cache, decoder, "a.img", 2, 2, 1, "scaled");
+		load(cache, decoder, "b.img", 2, 2, 2);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 3u);
+
+		// Loading a cached image again replaces it
+		Image::CachedImagePtr b = load(cache, decoder, "b.img", 3, 3, 4);
+		TS_ASSERT_EQUALS(cache.getImageCount(), 3u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 4u + 4u + 9u);
+		TS_ASSERT_EQUALS(cache.findImage("b.img").get(), b.get());
+
+		// All variants of a file are removed together
+		cache.removeImages("A.img");
+		TS_ASSERT_EQUALS(cache.getImageCount(), 1u);
+		TS_ASSERT_EQUALS(cache.getMemoryUsage(), 9u);
+		TS_ASSERT(!cache.findImage("a.img"));
+		TS_ASSERT(!cache.findImage("a.img", Graphics::PixelFormat(), "scaled"));
+	}
+
+	void test_decode_failure() {
+		Image::ImageCache cache;
+		TestImageDecoder decoder;
+
+		TS_ASSERT(!load(cache, decoder, "a.img", 0, 2, 1));
+		TS_ASSERT_EQUALS(cache.getImageCount(), 0u);
+	}
+};
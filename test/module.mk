@@ -5,8 +5,8 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/image/*.h
+TEST_LIBS    := audio/libaudio.a image/libimage.a graphics/libgraphics.a common/libcommon.a
 
 ifdef ENABLE_WINTERMUTE
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -607,54 +607,44 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 	// Reset any palette, if necessary
 	videoTrack->useInitialPalette();
 
-	int lastKeyFrame = -1;
-	int frameIndex = -1;
-	uint curFrame = 0;
+	// Figure out where we should be
+	const IndexEntries::StreamEntries *videoEntries = _indexEntries.getStreamEntries(videoIndex);
 
-	// Go through and figure out where we should be
-	// If there's a palette, we need to find the palette too
-	for (uint32 i = 0; i < _indexEntries.size(); i++) {
-		const OldIndex &index = _indexEntries[i];
+	if (!videoEntries || frame >= videoEntries->frames.size()) // This shouldn't happen.
+		return false;
 
-		// We don't care about RECs
-		if (index.id == ID_REC)
-			continue;
+	const int frameIndex = videoEntries->frames[frame];
 
-		// We're only looking at entries for this track
-		if (getStreamIndex(index.id) != videoIndex)
-			continue;
+	// Find the last keyframe up to the target frame. The first frame is
+	// always a keyframe, so there is one.
+	const Common::Array<uint32> &keyFrames = videoEntries->keyFrames;
+	uint32 lo = 0, hi = keyFrames.size();
 
-		uint16 streamType = getStreamType(index.id);
+	while (lo < hi) {
+		uint32 mid = (lo + hi) / 2;
 
-		if (streamType == kStreamTypePaletteChange) {
-			// We need to handle any palette change we see since there's no
-			// flag to tell if this is a "key" palette.
-			// Decode the palette
-			_fileStream->seek(_indexEntries[i].offset + 8);
-			Common::SeekableReadStream *chunk = 0;
+		if (keyFrames[mid] <= frame)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
 
-			if (_indexEntries[i].size != 0)
-				chunk = _fileStream->readStream(_indexEntries[i].size);
+	const uint keyFrame = keyFrames[lo - 1];
 
-			videoTrack->loadPaletteFromChunk(chunk);
-		} else {
-			// Check to see if this is a keyframe
-			// The first frame has to be a keyframe
-			if ((_indexEntries[i].flags & AVIIF_INDEX) || curFrame == 0)
-				lastKeyFrame = i;
+	// We need to handle any palette change before the frame since there's
+	// no flag to tell if this is a "key" palette.
+	for (uint32 i = 0; i < videoEntries->palettes.size() && (int)videoEntries->palettes[i] < frameIndex; i++) {
+		const OldIndex &index = _indexEntries[videoEntries->palettes[i]];
 
-			// Did we find the target frame?
-			if (frame == curFrame) {
-				frameIndex = i;
-				break;
-			}
+		// Decode the palette
+		_fileStream->seek(index.offset + 8);
+		Common::SeekableReadStream *chunk = 0;
 
-			curFrame++;
-		}
-	}
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
-	if (frameIndex < 0) // This shouldn't happen.
-		return false;
+		videoTrack->loadPaletteFromChunk(chunk);
+	}
 
 	// Update all the audio tracks
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
@@ -666,51 +656,31 @@ bool AVIDecoder::seekIntern(const Audio::Timestamp &time) {
 		// Set the chunk index for the track
 		audioTrack->setCurChunk(frame);
 
-		uint32 chunksFound = 0;
-		for (uint32 j = 0; j < _indexEntries.size(); j++) {
-			const OldIndex &index = _indexEntries[j];
-
-			// Continue ignoring RECs
-			if (index.id == ID_REC)
-				continue;
+		const IndexEntries::StreamEntries *audioEntries = _indexEntries.getStreamEntries(_audioTracks[i].index);
 
-			if (getStreamIndex(index.id) == _audioTracks[i].index) {
-				if (chunksFound == frame) {
-					_fileStream->seek(index.offset + 8);
-					Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
-					audioTrack->queueSound(audioChunk);
-					_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
-					break;
-				}
+		if (audioEntries && frame < audioEntries->chunks.size()) {
+			const uint32 j = audioEntries->chunks[frame];
+			const OldIndex &index = _indexEntries[j];
 
-				chunksFound++;
-			}
+			_fileStream->seek(index.offset + 8);
+			Common::SeekableReadStream *audioChunk = _fileStream->readStream(index.size);
+			audioTrack->queueSound(audioChunk);
+			_audioTracks[i].chunkSearchOffset = (j == _indexEntries.size() - 1) ? _movieListEnd : _indexEntries[j + 1].offset;
 		}
 
 		// Skip any audio to bring us to the right time
 		audioTrack->skipAudio(time, videoTrack->getFrameTime(frame));
 	}
 
-	// Decode from keyFrame to curFrame - 1
-	for (int i = lastKeyFrame; i < frameIndex; i++) {
-		if (_indexEntries[i].id == ID_REC)
-			continue;
-
-		if (getStreamIndex(_indexEntries[i].id) != videoIndex)
-			continue;
-
-		uint16 streamType = getStreamType(_indexEntries[i].id);
+	// Decode from keyFrame to frame - 1
+	for (uint i = keyFrame; i < frame; i++) {
+		const OldIndex &index = _indexEntries[videoEntries->frames[i]];
 
-		// Ignore palettes, they were already handled
-		if (streamType == kStreamTypePaletteChange)
-			continue;
-
-		// Frame, hopefully
-		_fileStream->seek(_indexEntries[i].offset + 8);
+		_fileStream->seek(index.offset + 8);
 		Common::SeekableReadStream *chunk = 0;
 
-		if (_indexEntries[i].size != 0)
-			chunk = _fileStream->readStream(_indexEntries[i].size);
+		if (index.size != 0)
+			chunk = _fileStream->readStream(index.size);
 
 		videoTrack->decodeFrame(chunk);
 	}
@@ -804,6 +774,8 @@ void AVIDecoder::readOldIndex(uint32 size) {
 		_indexEntries.push_back(indexEntry);
 		debug(7, "Index %d: Tag '%s', Offset = %d, Size = %d (Flags = %d)", i, tag2str(indexEntry.id), indexEntry.offset, indexEntry.size, indexEntry.flags);
 	}
+
+	_indexEntries.buildStreamEntries();
 }
 
 void AVIDecoder::checkTruemotion1() {
@@ -1081,15 +1053,53 @@ AVIDecoder::TrackStatus::TrackStatus() : track(0), chunkSearchOffset(0) {
 }
 
 AVIDecoder::OldIndex *AVIDecoder::IndexEntries::find(uint index, uint frameNumber) {
-	for (uint idx = 0, frameCtr = 0; idx < size(); ++idx) {
-		if ((*this)[idx].id != ID_REC &&
-				AVIDecoder::getStreamIndex((*this)[idx].id) == index) {
-			if (frameCtr++ == frameNumber)
-				return &(*this)[idx];
+	const StreamEntries *entries = getStreamEntries(index);
+
+	if (!entries || frameNumber >= entries->chunks.size())
+		return nullptr;
+
+	return &(*this)[entries->chunks[frameNumber]];
+}
+
+void AVIDecoder::IndexEntries::buildStreamEntries() {
+	_streams.clear();
+
+	for (uint idx = 0; idx < size(); ++idx) {
+		const OldIndex &entry = (*this)[idx];
+
+		// We don't care about RECs
+		if (entry.id == ID_REC)
+			continue;
+
+		const uint index = AVIDecoder::getStreamIndex(entry.id);
+		if (index >= _streams.size())
+			_streams.resize(index + 1);
+
+		StreamEntries &stream = _streams[index];
+		stream.chunks.push_back(idx);
+
+		if ((entry.id & 0xFFFF) == kStreamTypePaletteChange) {
+			stream.palettes.push_back(idx);
+		} else {
+			// The first frame has to be a keyframe
+			if ((entry.flags & AVIIF_INDEX) || stream.frames.empty())
+				stream.keyFrames.push_back(stream.frames.size());
+
+			stream.frames.push_back(idx);
 		}
 	}
+}
+
+const AVIDecoder::IndexEntries::StreamEntries *AVIDecoder::IndexEntries::getStreamEntries(uint index) const {
+	if (index >= _streams.size() || _streams[index].chunks.empty())
+		return nullptr;
+
+	return &_streams[index];
+}
 
-	return nullptr;
+void AVIDecoder::IndexEntries::clear() {
+	Common::Array<OldIndex>::clear();
+	_streams.clear();
 }
 
 } // End of namespace Video
@@ -295,6 +295,25 @@ protected:
 	class IndexEntries : public Common::Array<OldIndex> {
 	public:
 		OldIndex *find(uint index, uint frameNumber);
+
+		/** Positions in the index of the entries of one stream. */
+		struct StreamEntries {
+			Common::Array<uint32> chunks;    ///< All chunks
+			Common::Array<uint32> frames;    ///< The chunks that aren't palette changes
+			Common::Array<uint32> keyFrames; ///< Numbers of the frames that are keyframes
+			Common::Array<uint32> palettes;  ///< The palette change chunks
+		};
+
+		/** Build the per stream lookup tables, once all entries were added. */
+		void buildStreamEntries();
+
+		/** Get the entries of a stream, or 0 if it has none. */
+		const StreamEntries *getStreamEntries(uint index) const;
+
+		void clear();
+
+	private:
+		Common::Array<StreamEntries> _streams;
 	};
 
 	AVIHeader _header;
@@ -186,7 +186,7 @@ void BinkDecoder::readNextPacket() {
 			//                  Number of samples in bytes
 			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
+			audio.bits = new Common::BitStreamMemory32LELSB(new Common::SeekableSubReadStream(_bink,
 					audioPacketStart + 4, audioPacketEnd), DisposeAfterUse::YES);
 
 			audioTrack->decodePacket();
@@ -203,7 +203,7 @@ void BinkDecoder::readNextPacket() {
 	uint32 videoPacketStart = _bink->pos();
 	uint32 videoPacketEnd   = _bink->pos() + frameSize;
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
+	frame.bits = new Common::BitStreamMemory32LELSB(new Common::SeekableSubReadStream(_bink,
 			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
 
 	videoTrack->decodePacket(frame);
@@ -685,14 +685,15 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 
 	IDCT(block);
 
-	int16 *src   = block;
-	byte  *dest1 = ctx.dest;
-	byte  *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
-
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = src[i];
+	int16 *src  = block;
+	byte  *dest = ctx.dest;
+	byte   row[16];
+	for (int j = 0; j < 8; j++, dest += ctx.pitch << 1, src += 8) {
+		for (int i = 0; i < 8; i++)
+			row[2 * i] = row[2 * i + 1] = src[i];
 
+		memcpy(dest, row, 16);
+		memcpy(dest + ctx.pitch, row, 16);
 	}
 }
 
@@ -710,26 +711,31 @@ void BinkDecoder::BinkVideoTrack::blockScaledPattern(DecodeContext &ctx) {
 	for (int i = 0; i < 2; i++)
 		col[i] = getBundleValue(kSourceColors);
 
-	byte *dest1 = ctx.dest;
-	byte *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
+	byte *dest = ctx.dest;
+	byte  row[16];
+	for (int j = 0; j < 8; j++, dest += ctx.pitch << 1) {
 		byte v = getBundleValue(kSourcePattern);
 
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2, v >>= 1)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = col[v & 1];
+		for (int i = 0; i < 8; i++, v >>= 1)
+			row[2 * i] = row[2 * i + 1] = col[v & 1];
+
+		memcpy(dest, row, 16);
+		memcpy(dest + ctx.pitch, row, 16);
 	}
 }
 
 void BinkDecoder::BinkVideoTrack::blockScaledRaw(DecodeContext &ctx) {
-	byte row[8];
+	byte row[16];
 
-	byte *dest1 = ctx.dest;
-	byte *dest2 = ctx.dest + ctx.pitch;
-	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16) {
-		memcpy(row, _bundles[kSourceColors].curPtr, 8);
+	byte *dest = ctx.dest;
+	for (int j = 0; j < 8; j++, dest += ctx.pitch << 1) {
+		const byte *src = _bundles[kSourceColors].curPtr;
 
-		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
-			dest1[0] = dest1[1] = dest2[0] = dest2[1] = row[i];
+		for (int i = 0; i < 8; i++)
+			row[2 * i] = row[2 * i + 1] = src[i];
+
+		memcpy(dest, row, 16);
+		memcpy(dest + ctx.pitch, row, 16);
 
 		_bundles[kSourceColors].curPtr += 8;
 	}
@@ -1303,7 +1309,8 @@ void BinkDecoder::BinkVideoTrack::readResidue(VideoFrame &video, int16 *block, i
 #define MUNGE_ROW(x) (((x) + 0x7F)>>8)
 #define IDCT_ROW(dest,src) IDCT_TRANSFORM(dest,0,1,2,3,4,5,6,7,0,1,2,3,4,5,6,7,MUNGE_ROW,src)
 
-static inline void IDCTCol(int16 *dest, const int16 *src) {
+/** Column pass of the IDCT. Returns false if the column only has a DC coefficient. */
+static inline bool IDCTCol(int16 *dest, const int16 *src) {
 	if ((src[8] | src[16] | src[24] | src[32] | src[40] | src[48] | src[56]) == 0) {
 		dest[ 0] =
 		dest[ 8] =
@@ -1313,8 +1320,37 @@ static inline void IDCTCol(int16 *dest, const int16 *src) {
 		dest[40] =
 		dest[48] =
 		dest[56] = src[0];
+		return false;
+	}
+
+	IDCT_COL(dest, src);
+	return true;
+}
+
+/**
+ * Column pass over a whole block. Returns false if all columns only had a
+ * DC coefficient, in which case all rows of temp are identical and the row
+ * pass only has to be done once.
+ */
+static inline bool IDCTCols(int16 *temp, const int16 *block) {
+	bool hasAC = false;
+
+	for (int i = 0; i < 8; i++)
+		hasAC |= IDCTCol(&temp[i], &block[i]);
+
+	return hasAC;
+}
+
+/** Row pass of the IDCT; a row with only a DC coefficient is flat. */
+template<typename T>
+static inline void IDCTRow(T *dest, const int16 *src) {
+	if ((src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7]) == 0) {
+		const T v = MUNGE_ROW(src[0]);
+
+		dest[0] = dest[1] = dest[2] = dest[3] =
+		dest[4] = dest[5] = dest[6] = dest[7] = v;
 	} else {
-		IDCT_COL(dest, src);
+		IDCT_ROW(dest, src);
 	}
 }
 
@@ -1322,11 +1358,15 @@ void BinkDecoder::BinkVideoTrack::IDCT(int16 *block) {
 	int i;
 	int16 temp[64];
 
-	for (i = 0; i < 8; i++)
-		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+	if (!IDCTCols(temp, block)) {
+		IDCTRow(block, temp);
+		for (i = 1; i < 8; i++)
+			memcpy(&block[8*i], block, 8 * sizeof(int16));
+		return;
 	}
+
+	for (i = 0; i < 8; i++)
+		IDCTRow(&block[8*i], &temp[8*i]);
 }
 
 void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
@@ -1342,11 +1382,16 @@ void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int16 *block) {
 void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int16 *block) {
 	int i;
 	int16 temp[64];
-	for (i = 0; i < 8; i++)
-		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+
+	if (!IDCTCols(temp, block)) {
+		IDCTRow(ctx.dest, temp);
+		for (i = 1; i < 8; i++)
+			memcpy(&ctx.dest[i*ctx.pitch], ctx.dest, 8);
+		return;
 	}
+
+	for (i = 0; i < 8; i++)
+		IDCTRow(&ctx.dest[i*ctx.pitch], &temp[8*i]);
 }
 
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio) : _audioInfo(&audio) {
@@ -1505,7 +1550,17 @@ void BinkDecoder::BinkAudioTrack::readAudioCoeffs(float *coeffs) {
 }
 
 static inline int floatToInt16One(float src) {
-	return (int16)CLIP<int>((int)floor(src + 0.5), -32768, 32767);
+	// Same as CLIP<int>(floor(src + 0.5), -32768, 32767), but clipping
+	// first lets us truncate instead of calling floor() per sample.
+	const double v = src + 0.5;
+
+	if (v >= 32767.0)
+		return 32767;
+	if (v <= -32768.0)
+		return -32768;
+
+	const int i = (int)v;
+	return (i > v) ? i - 1 : i;
 }
 
 void BinkDecoder::BinkAudioTrack::floatToInt16Interleave(int16 *dst, const float **src, uint32 length, uint8 channels) {
@@ -150,6 +150,7 @@ private:
 		int getCurFrame() const { return _curFrame; }
 		int getFrameCount() const { return _frameCount; }
 		const Graphics::Surface *decodeNextFrame() { return &_surface; }
+		bool canDecodeAhead() const { return true; }
 
 		/** Decode a video packet. */
 		void decodePacket(VideoFrame &frame);
@@ -283,6 +283,8 @@ Audio::SeekableAudioStream *QuickTimeDecoder::AudioTrackHandler::getSeekableAudi
 }
 
 QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder, Common::QuickTimeParser::Track *parent) : _decoder(decoder), _parent(parent) {
+	buildSampleIndex();
+
 	_curEdit = 0;
 	enterNewEditList(false);
 
@@ -570,49 +572,51 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 	return Common::Rational(_parent->height) / _parent->scaleFactorY;
 }
 
-Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
+void QuickTimeDecoder::VideoTrackHandler::buildSampleIndex() {
+	// Walk the chunks once to find out which chunk holds each sample, and
+	// where in the chunk it is located. This keeps getNextFramePacket()
+	// from walking the sample tables for every frame.
 	uint32 sampleToChunkIndex = 0;
 
 	for (uint32 i = 0; i < _parent->chunkCount; i++) {
 		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
 			sampleToChunkIndex++;
 
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
+		if (sampleToChunkIndex == 0)
+			continue;
 
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
+		const Common::QuickTimeParser::SampleToChunkEntry &entry = _parent->sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = _parent->chunkOffsets[i];
 
-	if (actualChunk < 0)
-		error("Could not find data for frame %d", _curFrame);
+		for (uint32 j = 0; j < entry.count; j++) {
+			SampleInfo sample;
+			sample.offset = offset;
+			sample.descId = entry.id;
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+			if (_parent->sampleSize != 0)
+				sample.size = _parent->sampleSize;
+			else if (_samples.size() < _parent->sampleCount)
+				sample.size = _parent->sampleSizes[_samples.size()];
+			else
+				return;
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
-		else
-			stream->skip(_parent->sampleSizes[i]);
+			_samples.push_back(sample);
+			offset += sample.size;
+		}
 	}
+}
 
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
+Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
+	if (_curFrame < 0 || (uint32)_curFrame >= _samples.size())
+		error("Could not find data for frame %d", _curFrame);
 
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
+	const SampleInfo &sample = _samples[_curFrame];
+	descId = sample.descId;
 
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	// Read in the raw data for the frame
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(sample.offset);
+	return stream->readStream(sample.size);
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
@@ -631,9 +635,21 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getFrameDuration() {
 }
 
 uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+	// The sync sample table is sorted, so look for the last keyframe
+	// not after the frame with a binary search
+	uint32 lo = 0, hi = _parent->keyframeCount;
+
+	while (lo < hi) {
+		uint32 mid = (lo + hi) / 2;
+
+		if (_parent->keyframes[mid] <= frame)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo > 0)
+		return _parent->keyframes[lo - 1];
 
 	// If none found, we'll assume the requested frame is a key frame
 	return frame;
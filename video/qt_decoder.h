@@ -164,6 +164,16 @@ private:
 		Graphics::Surface *_ditherFrame;
 		const Graphics::Surface *forceDither(const Graphics::Surface &frame);
 
+		// Where to find each frame in the file, built on load
+		struct SampleInfo {
+			uint32 offset;
+			uint32 size;
+			uint32 descId;
+		};
+
+		Common::Array<SampleInfo> _samples;
+		void buildSampleIndex();
+
 		Common::SeekableReadStream *getNextFramePacket(uint32 &descId);
 		uint32 getFrameDuration();
 		uint32 findKeyFrame(uint32 frame) const;
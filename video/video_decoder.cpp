@@ -28,11 +28,19 @@
 #include "common/rational.h"
 #include "common/file.h"
 #include "common/system.h"
+#include "common/timer.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+// Decoders currently decoding ahead, all served by a single timer callback
+static Common::Array<VideoDecoder *> s_decodeAheadDecoders;
+
+// The decoder the timer callback tries first next time
+static uint s_decodeAheadNext = 0;
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -48,6 +56,12 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAheadLimit = 0;
+	_decodeAheadSurface = 0;
+	_decodeAheadBusy = false;
+	_decodeAheadStartTime = 0;
+	_decodeAheadCurFrame = -1;
+	_tracksLocked = 0;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -56,7 +70,22 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	// Decoders normally do this through close() already; make sure the
+	// timer callback can never be left with a pointer to a dead decoder
+	stopDecodeAhead();
+}
+
 void VideoDecoder::close() {
+	stopDecodeAhead();
+	flushDecodedFrames();
+
+	if (_decodeAheadSurface) {
+		_decodeAheadSurface->free();
+		delete _decodeAheadSurface;
+		_decodeAheadSurface = 0;
+	}
+
 	if (isPlaying())
 		stop();
 
@@ -93,10 +122,13 @@ bool VideoDecoder::loadFile(const Common::String &filename) {
 }
 
 bool VideoDecoder::needsUpdate() const {
+	Common::StackLock lock(_decodeAheadMutex);
 	return hasFramesLeft() && getTimeToNextFrame() == 0;
 }
 
 void VideoDecoder::pauseVideo(bool pause) {
+	TrackLock trackLock(this);
+
 	if (pause) {
 		_pauseLevel++;
 
@@ -175,6 +207,22 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+
+		if (!_decodedFrames.empty())
+			return popDecodedFrame();
+	}
+
+	// This waits for a frame the timer thread is still decoding, which is
+	// queued once it is done
+	TrackLock trackLock(this);
+
+	if (!_decodedFrames.empty())
+		return popDecodedFrame();
+
+	// Either we are not decoding ahead, or the timer did not keep up with
+	// us. In both cases, the tracks are exactly where the caller is.
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -195,11 +243,37 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+const Graphics::Surface *VideoDecoder::popDecodedFrame() {
+	DecodedFrame decoded = _decodedFrames.pop();
+
+	if (_decodeAheadSurface) {
+		_decodeAheadSurface->free();
+		delete _decodeAheadSurface;
+	}
+
+	_decodeAheadSurface = decoded.surface;
+
+	if (decoded.palette) {
+		memcpy(_decodeAheadPalette, decoded.palette, sizeof(_decodeAheadPalette));
+		delete[] decoded.palette;
+		_palette = _decodeAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	return _decodeAheadSurface;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
+	TrackLock trackLock(this);
+
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The queued frames would be shown in the wrong order
+	if (reverse && (isDecodingAhead() || !_decodedFrames.empty()))
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -220,6 +294,17 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	Common::StackLock lock(_decodeAheadMutex);
+
+	// The tracks must not be touched while the timer thread decodes a
+	// frame from them, so use where they were before it started
+	const int frame = _decodeAheadBusy ? _decodeAheadCurFrame : getTrackCurFrame();
+
+	// The tracks are ahead by the frames that have not been handed out yet
+	return frame - _decodedFrames.size();
+}
+
+int VideoDecoder::getTrackCurFrame() const {
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
@@ -261,13 +346,25 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	Common::StackLock lock(_decodeAheadMutex);
+
+	if (endOfVideo() || _needsUpdate)
+		return 0;
+
+	uint32 nextFrameStartTime;
+
+	if (!_decodedFrames.empty())
+		nextFrameStartTime = _decodedFrames.front().startTime;
+	else if (_decodeAheadBusy)
+		nextFrameStartTime = _decodeAheadStartTime;
+	else if (_nextVideoTrack)
+		nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	else
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
 
-	if (_nextVideoTrack->isReversed()) {
+	if (_decodedFrames.empty() && !_decodeAheadBusy && _nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -283,6 +380,11 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	Common::StackLock lock(_decodeAheadMutex);
+
+	if (!_decodedFrames.empty() || _decodeAheadBusy)
+		return false;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if (!(*it)->endOfTrack() && (!isPlaying() || (*it)->getTrackType() != Track::kTrackTypeVideo || !_endTimeSet || ((VideoTrack *)*it)->getNextFrameStartTime() < (uint)_endTime.msecs()))
 			return false;
@@ -305,6 +407,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	TrackLock trackLock(this);
+	flushDecodedFrames();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -339,6 +444,9 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	TrackLock trackLock(this);
+	flushDecodedFrames();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -405,6 +513,8 @@ void VideoDecoder::stop() {
 	if (!isPlaying())
 		return;
 
+	TrackLock trackLock(this);
+
 	// Stop audio here so we don't have it affect getTime()
 	stopAudio();
 
@@ -432,6 +542,8 @@ void VideoDecoder::setRate(const Common::Rational &rate) {
 	if (!isVideoLoaded() || _playbackRate == rate)
 		return;
 
+	TrackLock trackLock(this);
+
 	if (rate == 0) {
 		stop();
 		return;
@@ -778,6 +890,7 @@ uint VideoDecoder::getAudioTrackCount() const {
 }
 
 void VideoDecoder::setEndTime(const Audio::Timestamp &endTime) {
+	TrackLock trackLock(this);
 	Audio::Timestamp startTime = 0;
 
 	if (isPlaying()) {
@@ -892,6 +1005,15 @@ void VideoDecoder::startAudioLimit(const Audio::Timestamp &limit) {
 }
 
 bool VideoDecoder::hasFramesLeft() const {
+	if (!_decodedFrames.empty() || _decodeAheadBusy) {
+		const uint32 startTime = _decodedFrames.empty() ? _decodeAheadStartTime : _decodedFrames.front().startTime;
+		return !isPlaying() || !_endTimeSet || startTime < (uint)_endTime.msecs();
+	}
+
+	return hasTrackFramesLeft();
+}
+
+bool VideoDecoder::hasTrackFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
@@ -910,4 +1032,152 @@ bool VideoDecoder::hasAudio() const {
 	return false;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frameCount) {
+	if (frameCount == 0 || !isVideoLoaded()) {
+		stopDecodeAhead();
+		return false;
+	}
+
+	if (isDecodingAhead()) {
+		Common::StackLock lock(_decodeAheadMutex);
+		_decodeAheadLimit = frameCount;
+		return true;
+	}
+
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+			const VideoTrack *track = (const VideoTrack *)*it;
+
+			if (!track->canDecodeAhead() || track->isReversed())
+				return false;
+		}
+	}
+
+	// Frames decoded from now on may be handed out any time later
+	_canSetDither = false;
+	_decodeAheadLimit = frameCount;
+
+	Common::TimerManager *timer = g_system->getTimerManager();
+	timer->removeTimerProc(&decodeAheadProc);
+	s_decodeAheadDecoders.push_back(this);
+	timer->installTimerProc(&decodeAheadProc, 10000, 0, "videoDecodeAhead");
+	return true;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (!isDecodingAhead())
+		return;
+
+	// Once removed, the callback is guaranteed not to be running anymore
+	Common::TimerManager *timer = g_system->getTimerManager();
+	timer->removeTimerProc(&decodeAheadProc);
+
+	for (uint i = 0; i < s_decodeAheadDecoders.size(); i++) {
+		if (s_decodeAheadDecoders[i] == this) {
+			s_decodeAheadDecoders.remove_at(i);
+			break;
+		}
+	}
+
+	if (!s_decodeAheadDecoders.empty())
+		timer->installTimerProc(&decodeAheadProc, 10000, 0, "videoDecodeAhead");
+
+	// Frames still queued are handed out by decodeNextFrame() before it
+	// goes back to decoding synchronously.
+	_decodeAheadLimit = 0;
+}
+
+void VideoDecoder::flushDecodedFrames() {
+	while (!_decodedFrames.empty()) {
+		DecodedFrame decoded = _decodedFrames.pop();
+
+		if (decoded.surface) {
+			decoded.surface->free();
+			delete decoded.surface;
+		}
+
+		delete[] decoded.palette;
+	}
+}
+
+void VideoDecoder::decodeAheadProc(void *refCon) {
+	// The timer thread is shared with other callbacks, so decode at most
+	// one frame per call, taking turns between the decoders
+	const uint count = s_decodeAheadDecoders.size();
+
+	for (uint i = 0; i < count; i++) {
+		const uint index = (s_decodeAheadNext + i) % count;
+
+		if (s_decodeAheadDecoders[index]->decodeAhead()) {
+			s_decodeAheadNext = index + 1;
+			break;
+		}
+	}
+}
+
+bool VideoDecoder::decodeAhead() {
+	// Held until the frame is queued, so lockTracks() can wait on it
+	Common::StackLock trackLock(_decodeAheadTrackMutex);
+
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+
+		if (_tracksLocked || _decodedFrames.size() >= (int)_decodeAheadLimit || !_nextVideoTrack || !hasTrackFramesLeft())
+			return false;
+
+		// From here on, the main thread leaves the tracks alone until the
+		// frame is queued
+		_decodeAheadBusy = true;
+		_decodeAheadStartTime = _nextVideoTrack->getNextFrameStartTime();
+		_decodeAheadCurFrame = getTrackCurFrame();
+	}
+
+	DecodedFrame decoded;
+	decoded.surface = 0;
+	decoded.palette = 0;
+	decoded.startTime = _decodeAheadStartTime;
+
+	readNextPacket();
+
+	const Graphics::Surface *frame = _nextVideoTrack->decodeNextFrame();
+
+	if (frame) {
+		decoded.surface = new Graphics::Surface();
+		decoded.surface->copyFrom(*frame);
+	}
+
+	if (_nextVideoTrack->hasDirtyPalette()) {
+		decoded.palette = new byte[256 * 3];
+		memcpy(decoded.palette, _nextVideoTrack->getPalette(), 256 * 3);
+	}
+
+	Common::StackLock lock(_decodeAheadMutex);
+	findNextVideoTrack();
+	_decodedFrames.push(decoded);
+	_decodeAheadBusy = false;
+	return true;
+}
+
+void VideoDecoder::lockTracks() {
+	for (;;) {
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+
+			if (!_decodeAheadBusy) {
+				_tracksLocked++;
+				return;
+			}
+		}
+
+		// The timer thread holds this until its frame is queued
+		Common::StackLock wait(_decodeAheadTrackMutex);
+	}
+}
+
+void VideoDecoder::unlockTracks() {
+	Common::StackLock lock(_decodeAheadMutex);
+	assert(_tracksLocked);
+	_tracksLocked--;
+}
+
 } // End of namespace Video
@@ -26,6 +26,8 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/mutex.h"
+#include "common/queue.h"
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
@@ -52,7 +54,15 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+
+	/**
+	 * Stops decoding ahead, if still active.
+	 *
+	 * Subclasses whose tracks support decoding ahead have to call close()
+	 * in their own destructor, before anything the timer thread could
+	 * still be decoding from is gone.
+	 */
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -396,6 +406,37 @@ public:
 	 */
 	bool setDitheringPalette(const byte *palette);
 
+	/**
+	 * Decode frames ahead of time.
+	 *
+	 * When enabled, a timer callback keeps decoding frames into a queue of
+	 * up to frameCount converted surfaces, and decodeNextFrame() hands them
+	 * out in order. This keeps expensive frames (keyframes, mostly) from
+	 * stalling the caller. If the queue runs dry, decodeNextFrame() decodes
+	 * synchronously as usual.
+	 *
+	 * The frames are decoded on the shared timer thread, at most one frame
+	 * per timer callback for all decoders together. A single keyframe can
+	 * still take a while, and other timer callbacks (software MIDI drivers,
+	 * engine timers) are delayed by that long, so this is meant for videos
+	 * whose frames decode well within the frame duration.
+	 *
+	 * This only works if every video track supports it, see
+	 * VideoTrack::canDecodeAhead(), and not for reversed videos. It should
+	 * be called after loadStream() and after setDitheringPalette(). close()
+	 * turns it off again.
+	 *
+	 * @param frameCount The maximum number of queued frames, 0 to disable
+	 * @return true if frames are now decoded ahead, false otherwise
+	 */
+	bool setDecodeAhead(uint frameCount);
+
+	/**
+	 * Are frames being decoded ahead of time?
+	 * @see setDecodeAhead()
+	 */
+	bool isDecodingAhead() const { return _decodeAheadLimit != 0; }
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -633,6 +674,18 @@ protected:
 		 * Activate dithering mode with a palette
 		 */
 		virtual void setDither(const byte *palette) {}
+
+		/**
+		 * Can frames of this track be decoded from the timer thread?
+		 *
+		 * Returning true also vouches for the VideoDecoder's readNextPacket()
+		 * being safe to call from there, as it is called right before
+		 * decodeNextFrame(). A decoder overriding close() then has to call
+		 * VideoDecoder::close() before releasing anything it reads from.
+		 *
+		 * @see VideoDecoder::setDecodeAhead()
+		 */
+		virtual bool canDecodeAhead() const { return false; }
 	};
 
 	/**
@@ -950,6 +1003,66 @@ private:
 	int8 _audioBalance;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decode-ahead
+	struct DecodedFrame {
+		Graphics::Surface *surface;
+		byte *palette;
+		uint32 startTime;
+	};
+
+	Common::Queue<DecodedFrame> _decodedFrames;
+	uint _decodeAheadLimit;
+	Graphics::Surface *_decodeAheadSurface;
+	byte _decodeAheadPalette[256 * 3];
+
+	/**
+	 * Guards the queue and the state below. It is never held while a frame
+	 * is decoded, so the getters taking it do not wait for a decode.
+	 */
+	mutable Common::Mutex _decodeAheadMutex;
+
+	/** Held by the timer thread while it decodes a frame. */
+	Common::Mutex _decodeAheadTrackMutex;
+
+	/** Is the timer thread decoding a frame right now? */
+	bool _decodeAheadBusy;
+
+	/** The start time of the frame being decoded by the timer thread. */
+	uint32 _decodeAheadStartTime;
+
+	/** The tracks' current frame from before that frame was decoded. */
+	int _decodeAheadCurFrame;
+
+	/** The number of nested lockTracks() calls of the main thread. */
+	uint _tracksLocked;
+
+	/**
+	 * Wait for the frame being decoded ahead, if any, and keep the timer
+	 * thread from decoding more, until the matching unlockTracks(). Anything
+	 * changing the tracks or the playback state has to be enclosed in
+	 * these, and must not hold _decodeAheadMutex when calling lockTracks().
+	 */
+	void lockTracks();
+	void unlockTracks();
+
+	/** Calls lockTracks() and unlockTracks() for its scope. */
+	class TrackLock {
+	public:
+		TrackLock(VideoDecoder *decoder) : _decoder(decoder) { _decoder->lockTracks(); }
+		~TrackLock() { _decoder->unlockTracks(); }
+
+	private:
+		VideoDecoder *_decoder;
+	};
+
+	static void decodeAheadProc(void *refCon);
+	bool decodeAhead();
+	void stopDecodeAhead();
+	void flushDecodedFrames();
+	bool hasTrackFramesLeft() const;
+	int getTrackCurFrame() const;
+	const Graphics::Surface *popDecodedFrame();
 };
 
 } // End of namespace Video